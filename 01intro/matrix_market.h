@@ -0,0 +1,149 @@
+#ifndef MATRIX_MARKET_H
+#define MATRIX_MARKET_H
+
+// Matriz esparsa em CSR e leitor de Matrix Market, compartilhados por
+// multi_matrix_vector_sparse.c (OpenMP) e 16/codigo_sparse.c (MPI).
+// row_ptr é long para matrizes com mais de 2^31 não-zeros; quem distribui com MPI
+// confere que cada pedaço cabe nas contagens int.
+//
+//   CSRMatrix                          os não-zeros da linha i estão em val/col[row_ptr[i] .. row_ptr[i+1])
+//   cooToCSR(rows, cols, nnz, ..., &A) converte triplas (linha, coluna, valor); devolve 0 se deu certo
+//   loadMatrixMarket(path, &A)         lê um arquivo .mtx (coordinate, real/integer/pattern,
+//                                      general/symmetric/skew-symmetric); devolve 0 se deu certo
+//   freeCSR(&A)                        libera os vetores
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+typedef struct {
+  int rows, cols;
+  long nnz;
+  long *row_ptr;
+  int *col;
+  double *val;
+} CSRMatrix;
+
+static inline void freeCSR(CSRMatrix *A) {
+  free(A->row_ptr);
+  free(A->col);
+  free(A->val);
+  A->row_ptr = NULL;
+  A->col = NULL;
+  A->val = NULL;
+}
+
+static inline int cooToCSR(int rows, int cols, long nnz, const int *coo_row, const int *coo_col,
+                           const double *coo_val, CSRMatrix *A) {
+  A->rows = rows;
+  A->cols = cols;
+  A->nnz = nnz;
+  A->row_ptr = calloc(rows + 1, sizeof(long));
+  A->col = malloc(sizeof(int) * (nnz > 0 ? nnz : 1));
+  A->val = malloc(sizeof(double) * (nnz > 0 ? nnz : 1));
+  long *next = malloc(sizeof(long) * rows);
+
+  if (A->row_ptr == NULL || A->col == NULL || A->val == NULL || next == NULL){
+    free(next);
+    freeCSR(A);
+    return 1;
+  }
+
+  for (long k = 0; k < nnz; k++) A->row_ptr[coo_row[k] + 1]++;
+  for (int i = 0; i < rows; i++) A->row_ptr[i + 1] += A->row_ptr[i];
+  memcpy(next, A->row_ptr, sizeof(long) * rows);
+  for (long k = 0; k < nnz; k++){
+    long pos = next[coo_row[k]]++;
+    A->col[pos] = coo_col[k];
+    A->val[pos] = coo_val[k];
+  }
+
+  free(next);
+  return 0;
+}
+
+static inline int loadMatrixMarket(const char *path, CSRMatrix *A) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL){
+    printf("Erro ao abrir %s\n", path);
+    return 1;
+  }
+
+  char line[1024], object[64], format[64], field[64], symmetry[64];
+  if (fgets(line, sizeof(line), f) == NULL ||
+      sscanf(line, "%%%%MatrixMarket %63s %63s %63s %63s", object, format, field, symmetry) != 4 ||
+      strcasecmp(object, "matrix") != 0 || strcasecmp(format, "coordinate") != 0 ||
+      strcasecmp(field, "complex") == 0){
+    printf("Cabeçalho Matrix Market não suportado em %s\n", path);
+    fclose(f);
+    return 1;
+  }
+  int pattern = strcasecmp(field, "pattern") == 0;
+  int symmetric = strcasecmp(symmetry, "general") != 0; // symmetric / skew-symmetric / hermitian
+  int skew = strcasecmp(symmetry, "skew-symmetric") == 0;
+
+  do { // Pula os comentários
+    if (fgets(line, sizeof(line), f) == NULL){
+      printf("Arquivo %s sem linha de tamanho\n", path);
+      fclose(f);
+      return 1;
+    }
+  } while (line[0] == '%');
+
+  int rows, cols;
+  long entries;
+  if (sscanf(line, "%d %d %ld", &rows, &cols, &entries) != 3 || rows <= 0 || cols <= 0 || entries < 0){
+    printf("Linha de tamanho inválida em %s\n", path);
+    fclose(f);
+    return 1;
+  }
+
+  long capacity = symmetric ? 2 * entries : entries;
+  int *coo_row = malloc(sizeof(int) * (capacity > 0 ? capacity : 1));
+  int *coo_col = malloc(sizeof(int) * (capacity > 0 ? capacity : 1));
+  double *coo_val = malloc(sizeof(double) * (capacity > 0 ? capacity : 1));
+  if (coo_row == NULL || coo_col == NULL || coo_val == NULL){
+    printf("Erro ao alocar memória\n");
+    free(coo_row);
+    free(coo_col);
+    free(coo_val);
+    fclose(f);
+    return 1;
+  }
+
+  long nnz = 0;
+  for (long k = 0; k < entries; k++){
+    int i, j;
+    double v = 1.0;
+    int ok = pattern ? fscanf(f, "%d %d", &i, &j) == 2 : fscanf(f, "%d %d %lf%*[^\n]", &i, &j, &v) == 3;
+    if (!ok || i < 1 || i > rows || j < 1 || j > cols){
+      printf("Entrada %ld inválida em %s\n", k + 1, path);
+      free(coo_row);
+      free(coo_col);
+      free(coo_val);
+      fclose(f);
+      return 1;
+    }
+    coo_row[nnz] = i - 1; // Matrix Market é indexado a partir de 1
+    coo_col[nnz] = j - 1;
+    coo_val[nnz] = v;
+    nnz++;
+    if (symmetric && i != j){ // Só o triângulo inferior está no arquivo
+      coo_row[nnz] = j - 1;
+      coo_col[nnz] = i - 1;
+      coo_val[nnz] = skew ? -v : v;
+      nnz++;
+    }
+  }
+  fclose(f);
+
+  int err = cooToCSR(rows, cols, nnz, coo_row, coo_col, coo_val, A);
+  if (err) printf("Erro ao alocar memória\n");
+  free(coo_row);
+  free(coo_col);
+  free(coo_val);
+  return err;
+}
+
+#endif
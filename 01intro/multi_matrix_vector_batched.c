@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+// Multiplicação de uma matriz por um bloco de K vetores em uma única passada (Y = A * X).
+// Com um vetor por vez a matriz inteira é lida da DRAM K vezes; aqui cada elemento A[i][j]
+// é lido uma vez e reutilizado nos K vetores, então a intensidade aritmética cresce com K.
+// Compilar com: gcc -O3 -march=native multi_matrix_vector_batched.c -o mmv_batched
+//
+// Layout: X tem cols x K elementos (linha j guarda o elemento j dos K vetores) e Y tem rows x K.
+// Assim o laço mais interno percorre os K vetores de forma contígua e vetoriza.
+// Diferente de multi_matrix_vector.c, os elementos são double (como nas versões MPI de 16/ e 17/):
+// o ganho é medido em GFLOP/s, e com valores até 99 as somas continuam exatas até 2^53.
+
+#define MAX_K 64
+#define COL_BLOCK 512 // Bloco de colunas: COL_BLOCK x K doubles de X ficam na cache (256KB com K = 64)
+
+void fillTheMatrix(int rows, int cols, double *matrix) {
+  for (size_t i = 0; i < (size_t)rows * cols; i++){
+    matrix[i] = (double) ((i+1)%100);
+  }
+}
+
+// Preenche os K vetores; o vetor k é o vetor de multi_matrix_vector.c deslocado de k
+void fillTheVectors(int size, int k_vectors, double *vectors){
+  for(int j = 0; j < size; j++) {
+    for (int k = 0; k < k_vectors; k++){
+      vectors[(size_t)j * k_vectors + k] = (double) ((j+1+k)%100);
+    }
+  }
+}
+
+// Um vetor por vez (a referência): a matriz é percorrida inteira para cada vetor
+void multiplyMatrixVector(int rows, int cols, const double *matrix, const double *vector, int stride, double *result) {
+  for (int i = 0; i < rows; i++){
+    double sum = 0.0;
+    for (int j = 0; j < cols; j++){
+      sum += matrix[(size_t)i*cols + j] * vector[(size_t)j * stride];
+    }
+    result[(size_t)i * stride] = sum;
+  }
+}
+
+// Núcleo em lote: Y[i][0..K) += A[i][j] * X[j][0..K), com blocos de colunas para manter X na cache.
+// É "inline" para que, chamado com K constante, o compilador desenrole o laço dos K vetores.
+static inline __attribute__((always_inline))
+void batchedKernel(int rows, int cols, const int k_vectors, const double *matrix,
+                   const double *vectors, double *results) {
+  for (int jb = 0; jb < cols; jb += COL_BLOCK){
+    int je = jb + COL_BLOCK < cols ? jb + COL_BLOCK : cols;
+    for (int i = 0; i < rows; i++){
+      const double *row = matrix + (size_t)i * cols;
+      double acc[MAX_K] = {0}; // Acumuladores dos K vetores para a linha i (ficam em registradores/L1)
+
+      for (int j = jb; j < je; j++){
+        double a = row[j];
+        const double *x = vectors + (size_t)j * k_vectors;
+        #pragma omp simd
+        for (int k = 0; k < k_vectors; k++){
+          acc[k] += a * x[k];
+        }
+      }
+
+      double *y = results + (size_t)i * k_vectors;
+      #pragma omp simd
+      for (int k = 0; k < k_vectors; k++){
+        y[k] += acc[k];
+      }
+    }
+  }
+}
+
+// API em lote: multiplica a matriz pelos K vetores de uma vez
+void multiplyMatrixVectorBatched(int rows, int cols, int k_vectors, const double *matrix,
+                                 const double *vectors, double *results) {
+  if (k_vectors == 1){ // Sem reutilização possível: o laço simples é o mais rápido
+    multiplyMatrixVector(rows, cols, matrix, vectors, 1, results);
+    return;
+  }
+
+  memset(results, 0, sizeof(double) * (size_t)rows * k_vectors);
+
+  switch (k_vectors){ // Especializações com K constante para as potências de 2 usuais
+    case 2:  batchedKernel(rows, cols, 2, matrix, vectors, results); break;
+    case 4:  batchedKernel(rows, cols, 4, matrix, vectors, results); break;
+    case 8:  batchedKernel(rows, cols, 8, matrix, vectors, results); break;
+    case 16: batchedKernel(rows, cols, 16, matrix, vectors, results); break;
+    case 32: batchedKernel(rows, cols, 32, matrix, vectors, results); break;
+    case 64: batchedKernel(rows, cols, 64, matrix, vectors, results); break;
+    default: batchedKernel(rows, cols, k_vectors, matrix, vectors, results); break;
+  }
+}
+
+double elapsedSeconds(struct timeval start, struct timeval end) {
+  return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+  if(argc != 3) {
+    printf("Uso: %s <número de linhas> <número de colunas>\n", argv[0]);
+    return 1;
+  }
+
+  int rows = atoi(argv[1]);
+  int cols = atoi(argv[2]);
+
+  if(rows <= 0 || cols <= 0) {
+    printf("O valor das linhas ou colunas não podem ser menores ou iguais a 0\n");
+    return 1;
+  }
+
+  double *matrix = malloc(sizeof(double) * (size_t)rows * cols);
+  double *vectors = malloc(sizeof(double) * (size_t)cols * MAX_K);
+  double *results = malloc(sizeof(double) * (size_t)rows * MAX_K);
+  double *reference = malloc(sizeof(double) * (size_t)rows * MAX_K);
+
+  if (matrix == NULL || vectors == NULL || results == NULL || reference == NULL){
+    printf("Erro ao alocar memória\n");
+    free(matrix);
+    free(vectors);
+    free(results);
+    free(reference);
+    return 1;
+  }
+
+  fillTheMatrix(rows, cols, matrix);
+
+  // Tempo de referência: um único vetor multiplicado da forma tradicional
+  fillTheVectors(cols, 1, vectors);
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  multiplyMatrixVector(rows, cols, matrix, vectors, 1, reference);
+  gettimeofday(&end, NULL);
+  double single_time = elapsedSeconds(start, end);
+  printf("Um vetor por vez: %f segundos por vetor\n\n", single_time);
+
+  int ok = 1;
+  printf("%4s %14s %14s %12s %10s %s\n", "K", "tempo (s)", "vetores/s", "GFLOP/s", "ganho", "conferência");
+  for (int k_vectors = 1; k_vectors <= MAX_K; k_vectors *= 2){
+    fillTheVectors(cols, k_vectors, vectors);
+
+    gettimeofday(&start, NULL);
+    multiplyMatrixVectorBatched(rows, cols, k_vectors, matrix, vectors, results);
+    gettimeofday(&end, NULL);
+    double batched_time = elapsedSeconds(start, end);
+
+    // Confere os K resultados contra a versão de um vetor por vez (fora da medição)
+    for (int k = 0; k < k_vectors; k++){
+      multiplyMatrixVector(rows, cols, matrix, vectors + k, k_vectors, reference + k);
+    }
+    int errors = 0;
+    for (size_t i = 0; i < (size_t)rows * k_vectors; i++){
+      if (results[i] != reference[i]) errors++; // Inteiros pequenos: soma exata em qualquer ordem
+    }
+    if (errors) ok = 0;
+
+    double flops = 2.0 * rows * cols * k_vectors;
+    printf("%4d %14f %14.1f %12.2f %9.2fx %s\n", k_vectors, batched_time,
+           k_vectors / batched_time, flops / batched_time / 1e9,
+           single_time * k_vectors / batched_time, errors == 0 ? "ok" : "ERRO");
+  }
+
+  free(matrix);
+  free(vectors);
+  free(results);
+  free(reference);
+
+  return ok ? 0 : 1;
+}
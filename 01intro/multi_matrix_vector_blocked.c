@@ -0,0 +1,359 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Versão com blocagem em registradores e em cache da multiplicação matriz-vetor.
+// Compilar com: gcc -O3 -march=native multi_matrix_vector_blocked.c -o mmv_blocked
+// O caminho SIMD (AVX-512, AVX2 ou escalar) é escolhido em tempo de compilação pelas flags da -march.
+
+#define ROW_BLOCK 4     // Linhas processadas por passada: cada carga de vector[j] é reutilizada 4 vezes
+#define COL_BLOCK 4096  // Colunas por bloco: o pedaço do vetor (16KB int / 32KB double) é lido da memória
+                        // uma vez e reaproveitado da L1/L2 por todas as linhas da matriz
+#define ALIGNMENT 64
+
+// O kernel int só precisa de AVX2; o double usa FMA
+#if defined(__AVX512F__)
+#define ISA_INT "AVX-512"
+#define ISA_DOUBLE "AVX-512"
+#else
+#if defined(__AVX2__)
+#define ISA_INT "AVX2"
+#else
+#define ISA_INT "escalar"
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+#define ISA_DOUBLE "AVX2+FMA"
+#else
+#define ISA_DOUBLE "escalar"
+#endif
+#endif
+
+void *alignedAlloc(size_t bytes) {
+  size_t rounded = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; // aligned_alloc exige múltiplo do alinhamento
+  return aligned_alloc(ALIGNMENT, rounded);
+}
+
+void fillTheMatrixInt(int rows, int cols, int *matrix) {
+  for (size_t i = 0; i < (size_t)rows * cols; i++){
+    matrix[i] = (int) ((i+1)%100); // Pra não ficar um número muito grande e estourar
+  }
+}
+
+void fillTheVectorInt(int size, int *vector){
+  for(int i = 0; i < size; i++) {
+    vector[i] = (i+1)%100;
+  }
+}
+
+void fillTheMatrixDouble(int rows, int cols, double *matrix) {
+  for (size_t i = 0; i < (size_t)rows * cols; i++){
+    matrix[i] = (double) ((i+1)%100);
+  }
+}
+
+void fillTheVectorDouble(int size, double *vector){
+  for(int i = 0; i < size; i++) {
+    vector[i] = (double) ((i+1)%100);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Kernels de um bloco ROW_BLOCK x [j0, j1): acumulam em out[0..ROW_BLOCK-1]
+// ---------------------------------------------------------------------------
+
+#if defined(__AVX2__) && !defined(__AVX512F__)
+static inline int hsumInt256(__m256i v) {
+  __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(s);
+}
+
+static inline double hsumDouble256(__m256d v) {
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+  return _mm_cvtsd_f64(s);
+}
+#endif
+
+static void blockKernelInt(const int *m0, const int *m1, const int *m2, const int *m3,
+                           const int *vector, int j0, int j1, int *out) {
+  int j = j0;
+  int s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+#if defined(__AVX512F__)
+  __m512i a0 = _mm512_setzero_si512(), a1 = _mm512_setzero_si512();
+  __m512i a2 = _mm512_setzero_si512(), a3 = _mm512_setzero_si512();
+  for (; j + 16 <= j1; j += 16){
+    __m512i v = _mm512_loadu_si512(vector + j); // Uma carga do vetor serve às 4 linhas
+    a0 = _mm512_add_epi32(a0, _mm512_mullo_epi32(_mm512_loadu_si512(m0 + j), v));
+    a1 = _mm512_add_epi32(a1, _mm512_mullo_epi32(_mm512_loadu_si512(m1 + j), v));
+    a2 = _mm512_add_epi32(a2, _mm512_mullo_epi32(_mm512_loadu_si512(m2 + j), v));
+    a3 = _mm512_add_epi32(a3, _mm512_mullo_epi32(_mm512_loadu_si512(m3 + j), v));
+  }
+  s0 = _mm512_reduce_add_epi32(a0);
+  s1 = _mm512_reduce_add_epi32(a1);
+  s2 = _mm512_reduce_add_epi32(a2);
+  s3 = _mm512_reduce_add_epi32(a3);
+#elif defined(__AVX2__)
+  __m256i a0 = _mm256_setzero_si256(), a1 = _mm256_setzero_si256();
+  __m256i a2 = _mm256_setzero_si256(), a3 = _mm256_setzero_si256();
+  for (; j + 8 <= j1; j += 8){
+    __m256i v = _mm256_loadu_si256((const __m256i *)(vector + j));
+    a0 = _mm256_add_epi32(a0, _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(m0 + j)), v));
+    a1 = _mm256_add_epi32(a1, _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(m1 + j)), v));
+    a2 = _mm256_add_epi32(a2, _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(m2 + j)), v));
+    a3 = _mm256_add_epi32(a3, _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(m3 + j)), v));
+  }
+  s0 = hsumInt256(a0);
+  s1 = hsumInt256(a1);
+  s2 = hsumInt256(a2);
+  s3 = hsumInt256(a3);
+#endif
+
+  for (; j < j1; j++){ // Resto das colunas (ou o kernel inteiro no caminho escalar)
+    int v = vector[j];
+    s0 += m0[j] * v;
+    s1 += m1[j] * v;
+    s2 += m2[j] * v;
+    s3 += m3[j] * v;
+  }
+
+  out[0] += s0;
+  out[1] += s1;
+  out[2] += s2;
+  out[3] += s3;
+}
+
+static void blockKernelDouble(const double *m0, const double *m1, const double *m2, const double *m3,
+                              const double *vector, int j0, int j1, double *out) {
+  int j = j0;
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+
+#if defined(__AVX512F__)
+  __m512d a0 = _mm512_setzero_pd(), a1 = _mm512_setzero_pd();
+  __m512d a2 = _mm512_setzero_pd(), a3 = _mm512_setzero_pd();
+  for (; j + 8 <= j1; j += 8){
+    __m512d v = _mm512_loadu_pd(vector + j);
+    a0 = _mm512_fmadd_pd(_mm512_loadu_pd(m0 + j), v, a0);
+    a1 = _mm512_fmadd_pd(_mm512_loadu_pd(m1 + j), v, a1);
+    a2 = _mm512_fmadd_pd(_mm512_loadu_pd(m2 + j), v, a2);
+    a3 = _mm512_fmadd_pd(_mm512_loadu_pd(m3 + j), v, a3);
+  }
+  s0 = _mm512_reduce_add_pd(a0);
+  s1 = _mm512_reduce_add_pd(a1);
+  s2 = _mm512_reduce_add_pd(a2);
+  s3 = _mm512_reduce_add_pd(a3);
+#elif defined(__AVX2__) && defined(__FMA__)
+  __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+  __m256d a2 = _mm256_setzero_pd(), a3 = _mm256_setzero_pd();
+  for (; j + 4 <= j1; j += 4){
+    __m256d v = _mm256_loadu_pd(vector + j);
+    a0 = _mm256_fmadd_pd(_mm256_loadu_pd(m0 + j), v, a0);
+    a1 = _mm256_fmadd_pd(_mm256_loadu_pd(m1 + j), v, a1);
+    a2 = _mm256_fmadd_pd(_mm256_loadu_pd(m2 + j), v, a2);
+    a3 = _mm256_fmadd_pd(_mm256_loadu_pd(m3 + j), v, a3);
+  }
+  s0 = hsumDouble256(a0);
+  s1 = hsumDouble256(a1);
+  s2 = hsumDouble256(a2);
+  s3 = hsumDouble256(a3);
+#endif
+
+  for (; j < j1; j++){
+    double v = vector[j];
+    s0 += m0[j] * v;
+    s1 += m1[j] * v;
+    s2 += m2[j] * v;
+    s3 += m3[j] * v;
+  }
+
+  out[0] += s0;
+  out[1] += s1;
+  out[2] += s2;
+  out[3] += s3;
+}
+
+// ---------------------------------------------------------------------------
+// Motor: para cada bloco de COL_BLOCK colunas, percorre todas as linhas de ROW_BLOCK em
+// ROW_BLOCK, somando a parcial do bloco em result. O pedaço vector[jb, je) fica na cache durante
+// a passada inteira, em vez de ser relido da memória para cada grupo de linhas.
+// ---------------------------------------------------------------------------
+
+void multiplyMatrixVectorInt(int rows, int cols, const int *matrix, const int *vector, int *result) {
+  for (int jb = 0; jb < cols; jb += COL_BLOCK){
+    int je = jb + COL_BLOCK < cols ? jb + COL_BLOCK : cols;
+    int i = 0;
+    for (; i + ROW_BLOCK <= rows; i += ROW_BLOCK){
+      const int *m0 = matrix + (size_t)i * cols;
+      blockKernelInt(m0, m0 + cols, m0 + 2 * (size_t)cols, m0 + 3 * (size_t)cols, vector, jb, je, result + i);
+    }
+
+    for (; i < rows; i++){ // Linhas restantes quando rows não é múltiplo de ROW_BLOCK
+      const int *row = matrix + (size_t)i * cols;
+      int sum = 0;
+      for (int j = jb; j < je; j++){
+        sum += row[j] * vector[j];
+      }
+      result[i] += sum;
+    }
+  }
+}
+
+void multiplyMatrixVectorDouble(int rows, int cols, const double *matrix, const double *vector, double *result) {
+  for (int jb = 0; jb < cols; jb += COL_BLOCK){
+    int je = jb + COL_BLOCK < cols ? jb + COL_BLOCK : cols;
+    int i = 0;
+    for (; i + ROW_BLOCK <= rows; i += ROW_BLOCK){
+      const double *m0 = matrix + (size_t)i * cols;
+      blockKernelDouble(m0, m0 + cols, m0 + 2 * (size_t)cols, m0 + 3 * (size_t)cols, vector, jb, je, result + i);
+    }
+
+    for (; i < rows; i++){
+      const double *row = matrix + (size_t)i * cols;
+      double sum = 0.0;
+      for (int j = jb; j < je; j++){
+        sum += row[j] * vector[j];
+      }
+      result[i] += sum;
+    }
+  }
+}
+
+// Versões ingênuas (as mesmas de multi_matrix_vector.c) usadas para conferir o resultado
+void multiplyMatrixVectorIntNaive(int rows, int cols, const int *matrix, const int *vector, int *result) {
+  for (int i = 0; i < rows; i++){
+    for (int j = 0; j < cols; j++){
+      result[i] += matrix[(size_t)i*cols + j] * vector[j];
+    }
+  }
+}
+
+void multiplyMatrixVectorDoubleNaive(int rows, int cols, const double *matrix, const double *vector, double *result) {
+  for (int i = 0; i < rows; i++){
+    for (int j = 0; j < cols; j++){
+      result[i] += matrix[(size_t)i*cols + j] * vector[j];
+    }
+  }
+}
+
+double elapsedSeconds(struct timeval start, struct timeval end) {
+  return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+}
+
+// Bytes movidos da memória: a matriz inteira + o vetor + o resultado
+void printBandwidth(const char *label, int rows, int cols, size_t elem_size, double elapsed_time) {
+  double bytes = ((double)rows * cols + cols + rows) * elem_size;
+  printf("%s: %f segundos, %.2f GB/s\n", label, elapsed_time, bytes / elapsed_time / 1e9);
+}
+
+int runInt(int rows, int cols) {
+  int *matrix = alignedAlloc(sizeof(int) * (size_t)rows * cols);
+  int *vector = alignedAlloc(sizeof(int) * cols);
+  int *result = calloc(rows, sizeof(int));
+  int *reference = calloc(rows, sizeof(int));
+
+  if (matrix == NULL || vector == NULL || result == NULL || reference == NULL){
+    printf("Erro ao alocar memória\n");
+    free(matrix);
+    free(vector);
+    free(result);
+    free(reference);
+    return 1;
+  }
+
+  fillTheMatrixInt(rows, cols, matrix);
+  fillTheVectorInt(cols, vector);
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  multiplyMatrixVectorIntNaive(rows, cols, matrix, vector, reference);
+  gettimeofday(&end, NULL);
+  printBandwidth("Ingênua (int)", rows, cols, sizeof(int), elapsedSeconds(start, end));
+
+  gettimeofday(&start, NULL);
+  multiplyMatrixVectorInt(rows, cols, matrix, vector, result);
+  gettimeofday(&end, NULL);
+  printBandwidth("Blocada " ISA_INT " (int)", rows, cols, sizeof(int), elapsedSeconds(start, end));
+
+  int errors = 0;
+  for (int i = 0; i < rows; i++){
+    if (result[i] != reference[i]) errors++;
+  }
+  printf("Linhas divergentes: %d\n", errors);
+
+  free(matrix);
+  free(vector);
+  free(result);
+  free(reference);
+  return errors != 0;
+}
+
+int runDouble(int rows, int cols) {
+  double *matrix = alignedAlloc(sizeof(double) * (size_t)rows * cols);
+  double *vector = alignedAlloc(sizeof(double) * cols);
+  double *result = calloc(rows, sizeof(double));
+  double *reference = calloc(rows, sizeof(double));
+
+  if (matrix == NULL || vector == NULL || result == NULL || reference == NULL){
+    printf("Erro ao alocar memória\n");
+    free(matrix);
+    free(vector);
+    free(result);
+    free(reference);
+    return 1;
+  }
+
+  fillTheMatrixDouble(rows, cols, matrix);
+  fillTheVectorDouble(cols, vector);
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  multiplyMatrixVectorDoubleNaive(rows, cols, matrix, vector, reference);
+  gettimeofday(&end, NULL);
+  printBandwidth("Ingênua (double)", rows, cols, sizeof(double), elapsedSeconds(start, end));
+
+  gettimeofday(&start, NULL);
+  multiplyMatrixVectorDouble(rows, cols, matrix, vector, result);
+  gettimeofday(&end, NULL);
+  printBandwidth("Blocada " ISA_DOUBLE " (double)", rows, cols, sizeof(double), elapsedSeconds(start, end));
+
+  // Os valores são inteiros pequenos, então a soma em outra ordem é exata
+  int errors = 0;
+  for (int i = 0; i < rows; i++){
+    if (result[i] != reference[i]) errors++;
+  }
+  printf("Linhas divergentes: %d\n", errors);
+
+  free(matrix);
+  free(vector);
+  free(result);
+  free(reference);
+  return errors != 0;
+}
+
+int main(int argc, char* argv[]) {
+  if(argc != 3 && argc != 4) {
+    printf("Uso: %s <número de linhas> <número de colunas> [int|double]\n", argv[0]);
+    return 1;
+  }
+
+  int rows = atoi(argv[1]);
+  int cols = atoi(argv[2]);
+  const char *type = argc == 4 ? argv[3] : "int";
+
+  if(rows <= 0 || cols <= 0) {
+    printf("O valor das linhas ou colunas não podem ser menores ou iguais a 0\n");
+    return 1;
+  }
+
+  if (strcmp(type, "int") == 0) return runInt(rows, cols);
+  if (strcmp(type, "double") == 0) return runDouble(rows, cols);
+
+  printf("Tipo inválido: %s (use int ou double)\n", type);
+  return 1;
+}
@@ -0,0 +1,187 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <sys/time.h>
+#include <omp.h>
+
+// Versão paralela com OpenMP e alocação "first-touch" consciente de NUMA.
+// A página física só é alocada quando é escrita pela primeira vez, e vai para o nó NUMA
+// da thread que a escreveu. Por isso cada thread preenche exatamente o bloco de linhas
+// que ela mesma vai multiplicar depois (mesma divisão de linhas nas duas fases).
+// Compilar com: gcc -O3 -march=native -fopenmp multi_matrix_vector_omp.c -o mmv_omp
+// Executar com: OMP_PROC_BIND=close OMP_PLACES=cores ./mmv_omp <linhas> <colunas> <threads>
+
+#define MAX_SOCKETS 64
+
+// Intervalo [start, end) de linhas da thread tid: mesma divisão no preenchimento e na multiplicação
+void rowRange(int rows, int tid, int nthreads, int *start, int *end) {
+  int base = rows / nthreads;
+  int rest = rows % nthreads;
+  *start = tid * base + (tid < rest ? tid : rest);
+  *end = *start + base + (tid < rest ? 1 : 0);
+}
+
+// Socket (pacote físico) em que a CPU atual está, lido do sysfs
+int currentSocket(void) {
+  char path[128];
+  int cpu = sched_getcpu();
+  int socket = 0;
+
+  if (cpu < 0) return 0;
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+  FILE *f = fopen(path, "r");
+  if (f == NULL) return 0;
+  if (fscanf(f, "%d", &socket) != 1 || socket < 0 || socket >= MAX_SOCKETS) socket = 0;
+  fclose(f);
+  return socket;
+}
+
+void fillTheMatrix(int rows, int cols, int *matrix) {
+  #pragma omp parallel
+  {
+    int start, end;
+    rowRange(rows, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+    for (size_t i = (size_t)start * cols; i < (size_t)end * cols; i++){
+      matrix[i] = (int) ((i+1)%100); // Pra não ficar um número muito grande e estourar
+    }
+  }
+}
+
+void fillTheVector(int size, int *vector){
+  for(int i = 0; i < size; i++) {
+    vector[i] = (i+1)%100;
+  }
+}
+
+// Multiplicação paralela: cada thread calcula o seu bloco de linhas e registra o tempo
+// gasto e o socket onde rodou, para o relatório de banda por socket.
+// Devolve o número de threads que de fato rodaram.
+int multiplyMatrixVector(int rows, int cols, const int *matrix, const int *vector, int *result,
+                         double *thread_time, int *thread_socket) {
+  int team = 0;
+
+  #pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    int start, end;
+    rowRange(rows, tid, omp_get_num_threads(), &start, &end);
+    #pragma omp single nowait
+    team = omp_get_num_threads();
+
+    // O resultado também é tocado primeiro pela thread dona das linhas
+    for (int i = start; i < end; i++) result[i] = 0;
+    thread_socket[tid] = currentSocket();
+
+    #pragma omp barrier
+    double t0 = omp_get_wtime();
+    for (int i = start; i < end; i++){
+      const int *row = matrix + (size_t)i * cols;
+      int sum = 0;
+      #pragma omp simd reduction(+ : sum)
+      for (int j = 0; j < cols; j++){
+        sum += row[j] * vector[j];
+      }
+      result[i] = sum;
+    }
+    thread_time[tid] = omp_get_wtime() - t0;
+  }
+
+  return team;
+}
+
+int main(int argc, char* argv[]) {
+  if(argc != 3 && argc != 4) {
+    printf("Uso: %s <número de linhas> <número de colunas> [número de threads]\n", argv[0]);
+    return 1;
+  }
+
+  int rows = atoi(argv[1]);
+  int cols = atoi(argv[2]);
+  int nthreads = argc == 4 ? atoi(argv[3]) : omp_get_max_threads();
+
+  if(rows <= 0 || cols <= 0 || nthreads <= 0) {
+    printf("O valor das linhas, colunas ou threads não podem ser menores ou iguais a 0\n");
+    return 1;
+  }
+
+  omp_set_dynamic(0); // O time precisa ter exatamente nthreads no preenchimento e na multiplicação
+  omp_set_num_threads(nthreads);
+
+  // malloc (e não calloc) para que nenhuma página seja tocada antes do preenchimento paralelo
+  int *matrix = malloc(sizeof(int) * (size_t)rows * cols);
+  int *vector = malloc(sizeof(int) * cols);
+  int *result = malloc(sizeof(int) * rows);
+  double *thread_time = calloc(nthreads, sizeof(double));
+  int *thread_socket = calloc(nthreads, sizeof(int));
+
+  if (matrix == NULL || vector == NULL || result == NULL || thread_time == NULL || thread_socket == NULL){
+    printf("Erro ao alocar memória\n");
+    free(matrix);
+    free(vector);
+    free(result);
+    free(thread_time);
+    free(thread_socket);
+    return 1;
+  }
+
+  fillTheMatrix(rows, cols, matrix);
+  fillTheVector(cols, vector);
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  int team = multiplyMatrixVector(rows, cols, matrix, vector, result, thread_time, thread_socket);
+  gettimeofday(&end, NULL);
+
+  if (team != nthreads){
+    printf("O runtime criou %d threads em vez de %d\n", team, nthreads);
+    nthreads = team < nthreads ? team : nthreads; // Só há tempos e sockets dessas threads
+  }
+
+  // A banda usa o tempo do laço de multiplicação (a thread mais lenta), sem a criação das threads,
+  // a inicialização do resultado e a leitura do sysfs que estão dentro da chamada
+  double kernel_time = 0.0;
+  for (int t = 0; t < nthreads; t++)
+    if (thread_time[t] > kernel_time) kernel_time = thread_time[t];
+
+  double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+  double total_bytes = ((double)rows * cols + rows) * sizeof(int);
+  printf("Tempo de execução da multiplicação com %d threads: %f segundos (chamada inteira: %f segundos)\n",
+         nthreads, kernel_time, elapsed_time);
+  printf("Banda total: %.2f GB/s\n", kernel_time > 0 ? total_bytes / kernel_time / 1e9 : 0.0);
+
+  // Banda por socket: bytes das linhas de cada thread divididos pelo maior tempo das threads do socket
+  double socket_bytes[MAX_SOCKETS] = {0};
+  double socket_time[MAX_SOCKETS] = {0};
+  int socket_threads[MAX_SOCKETS] = {0};
+  for (int t = 0; t < nthreads; t++){
+    int s = thread_socket[t];
+    int row_start, row_end;
+    rowRange(rows, t, nthreads, &row_start, &row_end);
+    socket_bytes[s] += ((double)(row_end - row_start) * cols + (row_end - row_start)) * sizeof(int);
+    if (thread_time[t] > socket_time[s]) socket_time[s] = thread_time[t];
+    socket_threads[s]++;
+  }
+  for (int s = 0; s < MAX_SOCKETS; s++){
+    if (socket_threads[s] == 0) continue;
+    printf("Socket %d: %d threads, %.2f GB/s\n", s, socket_threads[s],
+           socket_time[s] > 0 ? socket_bytes[s] / socket_time[s] / 1e9 : 0.0);
+  }
+
+  // Conferência de todas as linhas com o cálculo sequencial
+  int errors = 0;
+  for (int i = 0; i < rows; i++){
+    int check = 0;
+    for (int j = 0; j < cols; j++) check += matrix[(size_t)i * cols + j] * vector[j];
+    if (check != result[i]) errors++;
+  }
+  printf("Linhas divergentes do cálculo sequencial: %d\n", errors);
+
+  free(matrix);
+  free(vector);
+  free(result);
+  free(thread_time);
+  free(thread_socket);
+
+  return errors != 0;
+}
@@ -0,0 +1,297 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <omp.h>
+#include "matrix_market.h"
+
+// Multiplicação matriz-vetor esparsa (SpMV) com OpenMP, nos formatos CSR e SELL-C-σ.
+// Quando mais de 95% da matriz é zero, guardar matrix[i*cols+j] desperdiça memória e banda;
+// os formatos esparsos guardam só os não-zeros e o índice da coluna de cada um.
+// Compilar com: gcc -O3 -march=native -fopenmp multi_matrix_vector_sparse.c -o mmv_sparse
+// Uso: ./mmv_sparse <linhas> <colunas> <densidade>   (matriz gerada, densidade em (0, 1])
+//      ./mmv_sparse -f <arquivo.mtx>                  (matriz no formato Matrix Market)
+
+#define SELL_C 8       // Altura do chunk: 8 linhas = um registrador AVX-512 de doubles
+#define SELL_SIGMA 256 // Janela de ordenação das linhas por tamanho (σ)
+
+// SELL-C-σ: linhas agrupadas em chunks de C, cada chunk guardado coluna a coluna e
+// completado com zeros até a linha mais longa do chunk. Dentro de cada janela de σ linhas
+// as linhas são ordenadas por tamanho, para que o preenchimento com zeros seja pequeno.
+typedef struct {
+  int rows, cols, n_chunks;
+  long *chunk_ptr; // Início de cada chunk em val/col
+  int *chunk_len;  // Número de "colunas" (tamanho da maior linha) de cada chunk
+  int *perm;       // perm[k] = linha original na posição k
+  int *col;
+  double *val;
+} SELLMatrix;
+
+void freeSELL(SELLMatrix *A) {
+  free(A->chunk_ptr);
+  free(A->chunk_len);
+  free(A->perm);
+  free(A->col);
+  free(A->val);
+}
+
+// Gera uma matriz esparsa com a densidade pedida, usando os mesmos valores de fillTheMatrix
+// ((i*cols+j+1)%100) nas posições não-zero, escolhidas por um hash determinístico.
+int fillTheSparseMatrix(int rows, int cols, double density, CSRMatrix *A) {
+  unsigned int threshold = (unsigned int)(density * 4294967295.0);
+  A->rows = rows;
+  A->cols = cols;
+  A->row_ptr = malloc(sizeof(long) * (rows + 1));
+  if (A->row_ptr == NULL) return 1;
+
+  // Primeira passada: conta os não-zeros de cada linha
+  A->row_ptr[0] = 0;
+  for (int i = 0; i < rows; i++){
+    long count = 0;
+    for (int j = 0; j < cols; j++){
+      unsigned int h = (unsigned int)((size_t)i * cols + j) * 2654435761u; // Hash multiplicativo de Knuth
+      h ^= h >> 16;
+      if (h <= threshold) count++;
+    }
+    A->row_ptr[i + 1] = A->row_ptr[i] + count;
+  }
+  A->nnz = A->row_ptr[rows];
+  A->col = malloc(sizeof(int) * (A->nnz > 0 ? A->nnz : 1));
+  A->val = malloc(sizeof(double) * (A->nnz > 0 ? A->nnz : 1));
+  if (A->col == NULL || A->val == NULL){
+    freeCSR(A);
+    return 1;
+  }
+
+  // Segunda passada: grava colunas e valores
+  for (int i = 0; i < rows; i++){
+    long pos = A->row_ptr[i];
+    for (int j = 0; j < cols; j++){
+      unsigned int h = (unsigned int)((size_t)i * cols + j) * 2654435761u;
+      h ^= h >> 16;
+      if (h <= threshold){
+        A->col[pos] = j;
+        A->val[pos] = (double)(((size_t)i * cols + j + 1) % 100);
+        pos++;
+      }
+    }
+  }
+  return 0;
+}
+
+static const CSRMatrix *sort_matrix; // Usado pelo qsort para comparar tamanhos de linha
+
+static int compareRowLength(const void *a, const void *b) {
+  int ra = *(const int *)a, rb = *(const int *)b;
+  long la = sort_matrix->row_ptr[ra + 1] - sort_matrix->row_ptr[ra];
+  long lb = sort_matrix->row_ptr[rb + 1] - sort_matrix->row_ptr[rb];
+  if (la != lb) return la < lb ? 1 : -1; // Decrescente
+  return ra - rb; // Desempate pela linha, para a ordem ser determinística
+}
+
+int csrToSELL(const CSRMatrix *A, SELLMatrix *S) {
+  S->rows = A->rows;
+  S->cols = A->cols;
+  S->n_chunks = (A->rows + SELL_C - 1) / SELL_C;
+  S->perm = malloc(sizeof(int) * S->n_chunks * SELL_C);
+  S->chunk_ptr = malloc(sizeof(long) * (S->n_chunks + 1));
+  S->chunk_len = malloc(sizeof(int) * S->n_chunks);
+  S->col = NULL;
+  S->val = NULL;
+  if (S->perm == NULL || S->chunk_ptr == NULL || S->chunk_len == NULL){
+    freeSELL(S);
+    return 1;
+  }
+
+  // Ordena as linhas por tamanho dentro de cada janela de σ linhas
+  for (int i = 0; i < A->rows; i++) S->perm[i] = i;
+  sort_matrix = A;
+  for (int start = 0; start < A->rows; start += SELL_SIGMA){
+    int count = start + SELL_SIGMA < A->rows ? SELL_SIGMA : A->rows - start;
+    qsort(S->perm + start, count, sizeof(int), compareRowLength);
+  }
+  for (int k = A->rows; k < S->n_chunks * SELL_C; k++) S->perm[k] = -1; // Linhas fictícias do último chunk
+
+  S->chunk_ptr[0] = 0;
+  for (int c = 0; c < S->n_chunks; c++){
+    int len = 0;
+    for (int r = 0; r < SELL_C; r++){
+      int row = S->perm[c * SELL_C + r];
+      if (row >= 0 && A->row_ptr[row + 1] - A->row_ptr[row] > len) len = (int)(A->row_ptr[row + 1] - A->row_ptr[row]);
+    }
+    S->chunk_len[c] = len;
+    S->chunk_ptr[c + 1] = S->chunk_ptr[c] + (long)len * SELL_C;
+  }
+
+  long storage = S->chunk_ptr[S->n_chunks];
+  S->col = calloc(storage > 0 ? storage : 1, sizeof(int));    // Preenchimento: coluna 0 ...
+  S->val = calloc(storage > 0 ? storage : 1, sizeof(double)); // ... com valor 0
+  if (S->col == NULL || S->val == NULL){
+    freeSELL(S);
+    return 1;
+  }
+
+  for (int c = 0; c < S->n_chunks; c++){
+    for (int r = 0; r < SELL_C; r++){
+      int row = S->perm[c * SELL_C + r];
+      if (row < 0) continue;
+      for (long k = A->row_ptr[row]; k < A->row_ptr[row + 1]; k++){
+        long pos = S->chunk_ptr[c] + (k - A->row_ptr[row]) * SELL_C + r;
+        S->col[pos] = A->col[k];
+        S->val[pos] = A->val[k];
+      }
+    }
+  }
+  return 0;
+}
+
+void fillTheVector(int size, double *vector){
+  for(int i = 0; i < size; i++) {
+    vector[i] = (double) ((i+1)%100);
+  }
+}
+
+void multiplyCSRSeq(const CSRMatrix *A, const double *vector, double *result) {
+  for (int i = 0; i < A->rows; i++){
+    double sum = 0.0;
+    for (long k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++){
+      sum += A->val[k] * vector[A->col[k]];
+    }
+    result[i] = sum;
+  }
+}
+
+void multiplyCSR(const CSRMatrix *A, const double *vector, double *result) {
+  // Blocos dinâmicos pequenos: o número de não-zeros por linha varia muito em matrizes reais
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < A->rows; i++){
+    double sum = 0.0;
+    for (long k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++){
+      sum += A->val[k] * vector[A->col[k]];
+    }
+    result[i] = sum;
+  }
+}
+
+void multiplySELL(const SELLMatrix *S, const double *vector, double *result) {
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (int c = 0; c < S->n_chunks; c++){
+    double tmp[SELL_C] = {0};
+    const double *val = S->val + S->chunk_ptr[c];
+    const int *col = S->col + S->chunk_ptr[c];
+
+    for (int j = 0; j < S->chunk_len[c]; j++){
+      #pragma omp simd
+      for (int r = 0; r < SELL_C; r++){ // As C linhas do chunk andam juntas: vetoriza com gather
+        tmp[r] += val[j * SELL_C + r] * vector[col[j * SELL_C + r]];
+      }
+    }
+
+    for (int r = 0; r < SELL_C; r++){
+      int row = S->perm[c * SELL_C + r];
+      if (row >= 0) result[row] = tmp[r];
+    }
+  }
+}
+
+double elapsedSeconds(struct timeval start, struct timeval end) {
+  return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+}
+
+// Compara com a versão sequencial, com tolerância relativa (a ordem da soma é a mesma)
+int countErrors(int rows, const double *result, const double *reference) {
+  int errors = 0;
+  for (int i = 0; i < rows; i++){
+    double diff = result[i] - reference[i];
+    double scale = reference[i] < 0 ? -reference[i] : reference[i];
+    if ((diff < 0 ? -diff : diff) > 1e-12 * (scale > 1.0 ? scale : 1.0)) errors++;
+  }
+  return errors;
+}
+
+int main(int argc, char* argv[]) {
+  CSRMatrix A;
+
+  if (argc == 3 && strcmp(argv[1], "-f") == 0){
+    if (loadMatrixMarket(argv[2], &A) != 0) return 1;
+  } else if (argc == 4){
+    int rows = atoi(argv[1]);
+    int cols = atoi(argv[2]);
+    double density = atof(argv[3]);
+    if(rows <= 0 || cols <= 0 || density <= 0.0 || density > 1.0) {
+      printf("Linhas e colunas devem ser positivas e a densidade deve estar em (0, 1]\n");
+      return 1;
+    }
+    if (fillTheSparseMatrix(rows, cols, density, &A) != 0){
+      printf("Erro ao alocar memória\n");
+      return 1;
+    }
+  } else {
+    printf("Uso: %s <número de linhas> <número de colunas> <densidade>\n", argv[0]);
+    printf("     %s -f <arquivo.mtx>\n", argv[0]);
+    return 1;
+  }
+
+  SELLMatrix S;
+  double *vector = malloc(sizeof(double) * A.cols);
+  double *result = malloc(sizeof(double) * A.rows);
+  double *reference = malloc(sizeof(double) * A.rows);
+
+  if (vector == NULL || result == NULL || reference == NULL || csrToSELL(&A, &S) != 0){
+    printf("Erro ao alocar memória\n");
+    freeCSR(&A);
+    free(vector);
+    free(result);
+    free(reference);
+    return 1;
+  }
+
+  fillTheVector(A.cols, vector);
+
+  printf("Matriz %dX%d com %ld não-zeros (%.3f%%), %d threads\n", A.rows, A.cols, A.nnz,
+         100.0 * A.nnz / ((double)A.rows * A.cols), omp_get_max_threads());
+  printf("Preenchimento do SELL-%d-%d: %.2f%%\n", SELL_C, SELL_SIGMA,
+         A.nnz > 0 ? 100.0 * (S.chunk_ptr[S.n_chunks] - A.nnz) / A.nnz : 0.0);
+
+  // Bytes lidos por um SpMV em CSR: valores + colunas + row_ptr + vetor + resultado
+  double csr_bytes = A.nnz * (sizeof(double) + sizeof(int)) + (A.rows + 1) * sizeof(long) +
+                     (A.cols + A.rows) * sizeof(double);
+  double flops = 2.0 * A.nnz;
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  multiplyCSRSeq(&A, vector, reference);
+  gettimeofday(&end, NULL);
+  double elapsed_time = elapsedSeconds(start, end);
+  printf("CSR sequencial: %f segundos, %.2f GFLOP/s, %.2f GB/s\n", elapsed_time,
+         flops / elapsed_time / 1e9, csr_bytes / elapsed_time / 1e9);
+
+  // Aquecimento: a primeira região paralela cria o time de threads, o que não é custo do SpMV
+  multiplyCSR(&A, vector, result);
+  multiplySELL(&S, vector, result);
+
+  gettimeofday(&start, NULL);
+  multiplyCSR(&A, vector, result);
+  gettimeofday(&end, NULL);
+  elapsed_time = elapsedSeconds(start, end);
+  printf("CSR OpenMP: %f segundos, %.2f GFLOP/s, %.2f GB/s, divergências: %d\n", elapsed_time,
+         flops / elapsed_time / 1e9, csr_bytes / elapsed_time / 1e9, countErrors(A.rows, result, reference));
+
+  gettimeofday(&start, NULL);
+  multiplySELL(&S, vector, result);
+  gettimeofday(&end, NULL);
+  elapsed_time = elapsedSeconds(start, end);
+  printf("SELL-%d-%d OpenMP: %f segundos, %.2f GFLOP/s, divergências: %d\n", SELL_C, SELL_SIGMA, elapsed_time,
+         flops / elapsed_time / 1e9, countErrors(A.rows, result, reference));
+
+  printf("Memória: densa %.1f MB, CSR %.1f MB\n", (double)A.rows * A.cols * sizeof(double) / 1e6,
+         (A.nnz * (sizeof(double) + sizeof(int)) + (A.rows + 1) * sizeof(long)) / 1e6);
+
+  freeCSR(&A);
+  freeSELL(&S);
+  free(vector);
+  free(result);
+  free(reference);
+
+  return 0;
+}
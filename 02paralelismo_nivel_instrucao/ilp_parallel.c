@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <omp.h>
+
+// Soma paralela sem estouro: acumuladores de 64 bits para int e soma compensada para double.
+// Cada thread soma um bloco contíguo com 8 acumuladores independentes (ILP, como sum_2 de ilp.c,
+// mas com epílogo fora do laço), e as somas parciais das threads são combinadas em árvore:
+// a cada nível a thread t soma a parcial da thread t + passo, em log2(threads) níveis.
+// Compilar com: gcc -O3 -march=native -fopenmp ilp_parallel.c -o ilp_parallel
+// Uso: ./ilp_parallel <tamanho do vetor> [int|double] [número de threads]
+
+#define ILP_ACC 8
+
+void fillVector(int *vector, long size) {
+  #pragma omp parallel for schedule(static)
+  for (long i = 0; i < size; i++) {
+    vector[i] = (i%100);
+  }
+}
+
+// Valores com parte fracionária para que a soma em double acumule erro de arredondamento
+void fillVectorDouble(double *vector, long size) {
+  #pragma omp parallel for schedule(static)
+  for (long i = 0; i < size; i++) {
+    vector[i] = (i%100) + 0.1;
+  }
+}
+
+// sum_1 de ilp.c: acumulador int, estoura para vetores grandes
+int sum_1(const int *vector, long size) {
+  int sum = 0;
+  for (long i = 0; i < size; i++){
+    sum += vector[i];
+  }
+  return sum;
+}
+
+// Referência sequencial em 64 bits
+long long sum_1_64(const int *vector, long size) {
+  long long sum = 0;
+  for (long i = 0; i < size; i++){
+    sum += vector[i];
+  }
+  return sum;
+}
+
+// Intervalo [start, end) da thread tid
+void blockRange(long size, int tid, int nthreads, long *start, long *end) {
+  long base = size / nthreads;
+  long rest = size % nthreads;
+  *start = tid * base + (tid < rest ? tid : rest);
+  *end = *start + base + (tid < rest ? 1 : 0);
+}
+
+// Soma int com ILP_ACC acumuladores de 64 bits
+long long sumBlock64(const int *vector, long start, long end) {
+  long long acc[ILP_ACC] = {0};
+  long i = start;
+  for (; i + ILP_ACC <= end; i += ILP_ACC){
+    for (int a = 0; a < ILP_ACC; a++) acc[a] += vector[i + a];
+  }
+  for (; i < end; i++) acc[0] += vector[i]; // Epílogo
+  long long sum = 0;
+  for (int a = 0; a < ILP_ACC; a++) sum += acc[a];
+  return sum;
+}
+
+long long parallelSum64(const int *vector, long size, long long *partial) {
+  #pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    int nthreads = omp_get_num_threads();
+    long start, end;
+    blockRange(size, tid, nthreads, &start, &end);
+    partial[tid] = sumBlock64(vector, start, end);
+
+    // Combinação em árvore
+    for (int step = 1; step < nthreads; step *= 2){
+      #pragma omp barrier
+      if (tid % (2 * step) == 0 && tid + step < nthreads)
+        partial[tid] += partial[tid + step];
+    }
+  }
+  return partial[0];
+}
+
+// Soma compensada (Kahan-Babuska/Neumaier): s guarda a soma e c o erro perdido nos arredondamentos
+typedef struct {
+  double s, c;
+} CompensatedSum;
+
+static inline void compensatedAdd(CompensatedSum *acc, double value) {
+  double t = acc->s + value;
+  if ((acc->s < 0 ? -acc->s : acc->s) >= (value < 0 ? -value : value))
+    acc->c += (acc->s - t) + value;
+  else
+    acc->c += (value - t) + acc->s;
+  acc->s = t;
+}
+
+static inline void compensatedMerge(CompensatedSum *acc, CompensatedSum other) {
+  compensatedAdd(acc, other.s);
+  acc->c += other.c;
+}
+
+// Soma double com ILP_ACC acumuladores compensados independentes
+CompensatedSum sumBlockCompensated(const double *vector, long start, long end) {
+  CompensatedSum acc[ILP_ACC];
+  memset(acc, 0, sizeof(acc));
+  long i = start;
+  for (; i + ILP_ACC <= end; i += ILP_ACC){
+    for (int a = 0; a < ILP_ACC; a++) compensatedAdd(&acc[a], vector[i + a]);
+  }
+  for (; i < end; i++) compensatedAdd(&acc[0], vector[i]);
+  for (int a = 1; a < ILP_ACC; a++) compensatedMerge(&acc[0], acc[a]);
+  return acc[0];
+}
+
+double parallelSumCompensated(const double *vector, long size, CompensatedSum *partial) {
+  #pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    int nthreads = omp_get_num_threads();
+    long start, end;
+    blockRange(size, tid, nthreads, &start, &end);
+    partial[tid] = sumBlockCompensated(vector, start, end);
+
+    for (int step = 1; step < nthreads; step *= 2){
+      #pragma omp barrier
+      if (tid % (2 * step) == 0 && tid + step < nthreads)
+        compensatedMerge(&partial[tid], partial[tid + step]);
+    }
+  }
+  return partial[0].s + partial[0].c;
+}
+
+double elapsedSeconds(struct timeval start, struct timeval end) {
+  return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+}
+
+int runInt(long size, int nthreads) {
+  int *vector = malloc(sizeof(int) * size);
+  long long *partial = malloc(sizeof(long long) * nthreads);
+  if (vector == NULL || partial == NULL){
+    printf("Erro ao alocar memória para o vetor");
+    free(vector);
+    free(partial);
+    return 1;
+  }
+
+  fillVector(vector, size);
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  int sum32 = sum_1(vector, size);
+  gettimeofday(&end, NULL);
+  printf("Tempo da soma 1 (int, sequencial): %f segundos\n", elapsedSeconds(start, end));
+
+  gettimeofday(&start, NULL);
+  long long reference = sum_1_64(vector, size);
+  gettimeofday(&end, NULL);
+  printf("Tempo da soma sequencial em 64 bits: %f segundos\n", elapsedSeconds(start, end));
+
+  gettimeofday(&start, NULL);
+  long long sum64 = parallelSum64(vector, size, partial);
+  gettimeofday(&end, NULL);
+  printf("Tempo da soma paralela em 64 bits (%d threads): %f segundos\n", nthreads, elapsedSeconds(start, end));
+
+  printf("SOMA 1 (int): %d%s\n", sum32, (long long)sum32 != reference ? " (estourou)" : "");
+  printf("SOMA sequencial 64 bits: %lld\n", reference);
+  printf("SOMA paralela 64 bits: %lld (%s)\n", sum64, sum64 == reference ? "confere" : "DIVERGE");
+
+  free(vector);
+  free(partial);
+  return sum64 != reference;
+}
+
+int runDouble(long size, int nthreads) {
+  double *vector = malloc(sizeof(double) * size);
+  CompensatedSum *partial = malloc(sizeof(CompensatedSum) * nthreads);
+  if (vector == NULL || partial == NULL){
+    printf("Erro ao alocar memória para o vetor");
+    free(vector);
+    free(partial);
+    return 1;
+  }
+
+  fillVectorDouble(vector, size);
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  double naive = 0.0;
+  for (long i = 0; i < size; i++) naive += vector[i];
+  gettimeofday(&end, NULL);
+  printf("Tempo da soma ingênua (double, sequencial): %f segundos\n", elapsedSeconds(start, end));
+
+  gettimeofday(&start, NULL);
+  CompensatedSum serial = {0.0, 0.0};
+  for (long i = 0; i < size; i++) compensatedAdd(&serial, vector[i]);
+  double reference = serial.s + serial.c;
+  gettimeofday(&end, NULL);
+  printf("Tempo da soma compensada sequencial: %f segundos\n", elapsedSeconds(start, end));
+
+  gettimeofday(&start, NULL);
+  double sum = parallelSumCompensated(vector, size, partial);
+  gettimeofday(&end, NULL);
+  printf("Tempo da soma compensada paralela (%d threads): %f segundos\n", nthreads, elapsedSeconds(start, end));
+
+  // Valor exato a partir dos doubles guardados (0.1 não é representável: vector[r] não é r + 0.1).
+  // O vetor só tem 100 valores distintos, vector[r] para r < 100, e cada um aparece full ou full + 1
+  // vezes. Em __float128 (113 bits de mantissa) cada produto valor x contagem é exato.
+  long full = size / 100;
+  __float128 exact = 0;
+  for (long r = 0; r < 100 && r < size; r++)
+    exact += (__float128)vector[r] * (full + (r < size % 100));
+
+  printf("SOMA ingênua: %.6f (erro %.3e)\n", naive, (double)(naive - exact));
+  printf("SOMA compensada sequencial: %.6f (erro %.3e)\n", reference, (double)(reference - exact));
+  printf("SOMA compensada paralela: %.6f (erro %.3e)\n", sum, (double)(sum - exact));
+
+  double diff = sum - reference;
+  double scale = reference > 1.0 ? reference : 1.0;
+  int ok = (diff < 0 ? -diff : diff) <= 1e-15 * scale * 4;
+  printf("Paralela x sequencial: %s\n", ok ? "confere" : "DIVERGE");
+
+  free(vector);
+  free(partial);
+  return !ok;
+}
+
+int main(int argc, char *argv[]){
+  if (argc < 2 || argc > 4){
+    printf("Uso: %s <tamanho do vetor> [int|double] [número de threads]\n", argv[0]);
+    return 1;
+  }
+
+  long size = atol(argv[1]); // long: vetores com mais de 2^31 elementos
+  const char *type = argc > 2 ? argv[2] : "int";
+  int nthreads = argc > 3 ? atoi(argv[3]) : omp_get_max_threads();
+
+  if (size <= 0 || nthreads <= 0){
+    printf("O tamanho do vetor e o número de threads devem ser positivos\n");
+    return 1;
+  }
+
+  omp_set_num_threads(nthreads);
+  omp_set_dynamic(0); // Garante exatamente nthreads threads (o vetor de parciais tem esse tamanho)
+
+  if (strcmp(type, "int") == 0) return runInt(size, nthreads);
+  if (strcmp(type, "double") == 0) return runDouble(size, nthreads);
+
+  printf("Tipo inválido: %s (use int ou double)\n", type);
+  return 1;
+}
@@ -0,0 +1,132 @@
+#ifndef ILP_SUM_H
+#define ILP_SUM_H
+
+// Somas de vetores de int com número de acumuladores escolhido em tempo de compilação.
+// Cada acumulador é uma cadeia de dependência independente: com K acumuladores o processador
+// pode ter K somas em andamento ao mesmo tempo (paralelismo em nível de instrução).
+// Os acumuladores são de 64 bits, como em ilp_parallel.c: a soma de 256 MB de ints já passa de
+// 2^31, e um acumulador int estouraria (comportamento indefinido em C).
+//
+// Para cada K em {1, 2, 4, 8, 16} são geradas as funções:
+//   ilp_sum_scalar_K  - K acumuladores long long (sem autovetorização, para isolar o efeito do ILP)
+//   ilp_sum_sse_K     - K pares de registradores SSE2 com 2+2 somas de 64 bits   (se compilado com SSE2)
+//   ilp_sum_avx2_K    - K pares de registradores AVX2 com 4+4 somas de 64 bits   (se compilado com -mavx2)
+//   ilp_sum_avx512_K  - K pares de registradores AVX-512 com 8+8 somas de 64 bits (se compilado com -mavx512f)
+// Nos caminhos SIMD cada carga de W ints é estendida com sinal para 64 bits (unpack com a máscara
+// de sinal) e somada em dois registradores, a metade baixa e a alta.
+// O resto do vetor é tratado depois do laço principal (epílogo), sem "if" dentro do laço:
+// primeiro os vetores completos que sobraram, com um único acumulador, e depois os elementos soltos.
+
+#include <immintrin.h>
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define ILP_NOVEC __attribute__((optimize("no-tree-vectorize")))
+#else
+#define ILP_NOVEC
+#endif
+
+#define ILP_DEFINE_SCALAR(K)                                         \
+  static ILP_NOVEC long long ilp_sum_scalar_##K(const int *v, long n){ \
+    long long acc[K] = {0};                                          \
+    long i = 0;                                                      \
+    for (; i + (K) <= n; i += (K)){                                  \
+      _Pragma("GCC unroll 16")                                       \
+      for (int a = 0; a < (K); a++) acc[a] += v[i + a];              \
+    }                                                                \
+    for (; i < n; i++) acc[0] += v[i];                               \
+    long long sum = 0;                                               \
+    for (int a = 0; a < (K); a++) sum += acc[a];                     \
+    return sum;                                                      \
+  }
+
+ILP_DEFINE_SCALAR(1)
+ILP_DEFINE_SCALAR(2)
+ILP_DEFINE_SCALAR(4)
+ILP_DEFINE_SCALAR(8)
+ILP_DEFINE_SCALAR(16)
+
+// Corpo comum às versões SIMD: VEC = tipo do registrador, W = ints por carga, ZERO/LOAD = intrínsecos,
+// WIDEN_ADD(lo, hi, v) soma os W ints de v, em 64 bits, nos registradores lo e hi,
+// ADD64 = soma de 64 bits, HSUM = soma horizontal de um registrador de 64 bits
+#define ILP_DEFINE_SIMD(NAME, K, VEC, W, ZERO, LOAD, WIDEN_ADD, ADD64, HSUM) \
+  static long long ilp_sum_##NAME##_##K(const int *v, long n){        \
+    VEC lo[K], hi[K];                                                 \
+    _Pragma("GCC unroll 16")                                          \
+    for (int a = 0; a < (K); a++) lo[a] = hi[a] = ZERO();             \
+    long i = 0;                                                       \
+    for (; i + (K) * (W) <= n; i += (K) * (W)){                       \
+      _Pragma("GCC unroll 16")                                        \
+      for (int a = 0; a < (K); a++)                                   \
+        WIDEN_ADD(lo[a], hi[a], LOAD(v + i + a * (W)));               \
+    }                                                                 \
+    for (; i + (W) <= n; i += (W))                                    \
+      WIDEN_ADD(lo[0], hi[0], LOAD(v + i));                           \
+    _Pragma("GCC unroll 16")                                          \
+    for (int a = 1; a < (K); a++){                                    \
+      lo[0] = ADD64(lo[0], lo[a]);                                    \
+      hi[0] = ADD64(hi[0], hi[a]);                                    \
+    }                                                                 \
+    long long sum = HSUM(ADD64(lo[0], hi[0]));                        \
+    for (; i < n; i++) sum += v[i];                                   \
+    return sum;                                                       \
+  }
+
+#if defined(__SSE2__)
+#define ILP_HAS_SSE 1
+static inline long long ilp_hsum_sse(__m128i s){
+  s = _mm_add_epi64(s, _mm_unpackhi_epi64(s, s));
+  return _mm_cvtsi128_si64(s);
+}
+#define ILP_LOAD_SSE(p) _mm_loadu_si128((const __m128i *)(p))
+#define ILP_WIDEN_ADD_SSE(lo, hi, v) do {                     \
+    __m128i x_ = (v), s_ = _mm_srai_epi32(x_, 31);            \
+    lo = _mm_add_epi64(lo, _mm_unpacklo_epi32(x_, s_));       \
+    hi = _mm_add_epi64(hi, _mm_unpackhi_epi32(x_, s_));       \
+  } while (0)
+#define ILP_SSE(K) ILP_DEFINE_SIMD(sse, K, __m128i, 4, _mm_setzero_si128, ILP_LOAD_SSE, \
+                                   ILP_WIDEN_ADD_SSE, _mm_add_epi64, ilp_hsum_sse)
+ILP_SSE(1)
+ILP_SSE(2)
+ILP_SSE(4)
+ILP_SSE(8)
+ILP_SSE(16)
+#endif
+
+#if defined(__AVX2__)
+#define ILP_HAS_AVX2 1
+static inline long long ilp_hsum_avx2(__m256i v){
+  __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+  return ilp_hsum_sse(s);
+}
+#define ILP_LOAD_AVX2(p) _mm256_loadu_si256((const __m256i *)(p))
+#define ILP_WIDEN_ADD_AVX2(lo, hi, v) do {                    \
+    __m256i x_ = (v), s_ = _mm256_srai_epi32(x_, 31);         \
+    lo = _mm256_add_epi64(lo, _mm256_unpacklo_epi32(x_, s_)); \
+    hi = _mm256_add_epi64(hi, _mm256_unpackhi_epi32(x_, s_)); \
+  } while (0)
+#define ILP_AVX2(K) ILP_DEFINE_SIMD(avx2, K, __m256i, 8, _mm256_setzero_si256, ILP_LOAD_AVX2, \
+                                    ILP_WIDEN_ADD_AVX2, _mm256_add_epi64, ilp_hsum_avx2)
+ILP_AVX2(1)
+ILP_AVX2(2)
+ILP_AVX2(4)
+ILP_AVX2(8)
+ILP_AVX2(16)
+#endif
+
+#if defined(__AVX512F__)
+#define ILP_HAS_AVX512 1
+#define ILP_WIDEN_ADD_AVX512(lo, hi, v) do {                  \
+    __m512i x_ = (v), s_ = _mm512_srai_epi32(x_, 31);         \
+    lo = _mm512_add_epi64(lo, _mm512_unpacklo_epi32(x_, s_)); \
+    hi = _mm512_add_epi64(hi, _mm512_unpackhi_epi32(x_, s_)); \
+  } while (0)
+#define ILP_AVX512(K) ILP_DEFINE_SIMD(avx512, K, __m512i, 16, _mm512_setzero_si512, _mm512_loadu_si512, \
+                                      ILP_WIDEN_ADD_AVX512, _mm512_add_epi64, _mm512_reduce_add_epi64)
+ILP_AVX512(1)
+ILP_AVX512(2)
+ILP_AVX512(4)
+ILP_AVX512(8)
+ILP_AVX512(16)
+#endif
+
+#endif
@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <x86intrin.h>
+#include "ilp_sum.h"
+
+// Varredura do número de acumuladores e da largura SIMD, com o vetor indo da L1 até a DRAM.
+// Compilar com: gcc -O3 -march=native ilp_sweep.c -o ilp_sweep
+// Os ciclos vêm do contador de tempo (rdtsc), que em CPUs recentes anda em frequência fixa:
+// com turbo ligado os números são "elementos por ciclo de referência".
+
+#define MIN_BYTES (4L << 10)   // 4 KB: cabe na L1
+#define MAX_BYTES (256L << 20) // 256 MB: bem maior que a LLC
+#define ELEMS_PER_POINT (1L << 26) // Elementos somados por medição (repete vetores pequenos)
+
+typedef long long (*sum_fn)(const int *, long);
+
+typedef struct {
+  const char *isa;
+  int accumulators;
+  sum_fn fn;
+} Variant;
+
+static const Variant variants[] = {
+  {"escalar", 1, ilp_sum_scalar_1}, {"escalar", 2, ilp_sum_scalar_2}, {"escalar", 4, ilp_sum_scalar_4},
+  {"escalar", 8, ilp_sum_scalar_8}, {"escalar", 16, ilp_sum_scalar_16},
+#ifdef ILP_HAS_SSE
+  {"sse", 1, ilp_sum_sse_1}, {"sse", 2, ilp_sum_sse_2}, {"sse", 4, ilp_sum_sse_4},
+  {"sse", 8, ilp_sum_sse_8}, {"sse", 16, ilp_sum_sse_16},
+#endif
+#ifdef ILP_HAS_AVX2
+  {"avx2", 1, ilp_sum_avx2_1}, {"avx2", 2, ilp_sum_avx2_2}, {"avx2", 4, ilp_sum_avx2_4},
+  {"avx2", 8, ilp_sum_avx2_8}, {"avx2", 16, ilp_sum_avx2_16},
+#endif
+#ifdef ILP_HAS_AVX512
+  {"avx512", 1, ilp_sum_avx512_1}, {"avx512", 2, ilp_sum_avx512_2}, {"avx512", 4, ilp_sum_avx512_4},
+  {"avx512", 8, ilp_sum_avx512_8}, {"avx512", 16, ilp_sum_avx512_16},
+#endif
+};
+
+#define N_VARIANTS (sizeof(variants) / sizeof(variants[0]))
+
+void fillVector(int *vector, long size) {
+  for (long i = 0; i < size; i++) {
+    vector[i] = (i%100);
+  }
+}
+
+int main(){
+  long max_elems = MAX_BYTES / sizeof(int);
+  int *vector = malloc(sizeof(int) * max_elems);
+
+  if(vector == NULL) {
+    printf("Erro ao alocar memória para o vetor");
+    return 1;
+  }
+
+  fillVector(vector, max_elems);
+
+  printf("Elementos por ciclo (rdtsc)\n%10s", "tamanho");
+  for (size_t v = 0; v < N_VARIANTS; v++){
+    printf(" %7s/%-2d", variants[v].isa, variants[v].accumulators);
+  }
+  printf("\n");
+
+  for (long bytes = MIN_BYTES; bytes <= MAX_BYTES; bytes *= 4){
+    // Um tamanho ímpar de elementos também exercita o epílogo
+    long size = bytes / sizeof(int) - 3;
+    long repeats = ELEMS_PER_POINT / size > 0 ? ELEMS_PER_POINT / size : 1;
+    long long reference = ilp_sum_scalar_1(vector, size);
+
+    if (bytes < (1L << 20)) printf("%7ld KB", bytes >> 10);
+    else printf("%7ld MB", bytes >> 20);
+
+    for (size_t v = 0; v < N_VARIANTS; v++){
+      volatile long long sink = variants[v].fn(vector, size); // Aquecimento: traz o vetor para a cache
+
+      if (sink != reference){
+        printf("\nResultado divergente em %s/%d: %lld != %lld\n", variants[v].isa,
+               variants[v].accumulators, sink, reference);
+        free(vector);
+        return 1;
+      }
+
+      unsigned long long start = __rdtsc();
+      for (long r = 0; r < repeats; r++){
+        sink = variants[v].fn(vector, size);
+      }
+      unsigned long long cycles = __rdtsc() - start;
+
+      printf(" %10.2f", (double)size * repeats / cycles);
+    }
+    printf("\n");
+  }
+
+  free(vector);
+
+  return 0;
+}
@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/time.h>
+#include <math.h>
+
+// Métodos de convergência acelerada para π, comparados pelo tempo até atingir uma tolerância.
+// A série de Leibniz tem erro ~1/n: 15 dígitos pedem ~10^15 termos. Os métodos abaixo chegam
+// na mesma precisão com dezenas de termos:
+//   Euler:      transformada de Euler da série de Leibniz, π/2 = Σ k! / (2k+1)!!  (erro ~2^-k)
+//   Richardson: extrapolação das somas parciais de Leibniz com n, 2n, 4n, ... termos
+//   Machin:     π = 16 arctan(1/5) - 4 arctan(1/239)
+//   BBP:        π = Σ 16^-k (4/(8k+1) - 2/(8k+4) - 1/(8k+5) - 1/(8k+6)), que também permite
+//               extrair dígitos hexadecimais de π numa posição qualquer sem calcular os anteriores
+// Compilar com: gcc -O3 serie_pi_accel.c -o serie_pi_accel -lm
+// Uso: ./serie_pi_accel <número de iterações> [tolerância] [posição hexadecimal]
+
+#define LEIBNIZ_MAX_TERMS 2000000000L // Limite para Leibniz na busca pela tolerância
+#define RICHARDSON_BASE 8              // Número de termos da primeira soma parcial
+#define RICHARDSON_MAX_LEVELS 20
+
+double leibniz_pi(long n_terms){ // PI/4 = 1 - 1/3 + 1/5 - 1/7 + 1/9...
+  double pi_approx = 0.0;
+  for (long k = 0; k < n_terms; k++){
+    pi_approx += (k % 2 == 0 ? 1.0 : -1.0) / (2 * k + 1);
+  }
+  return 4 * pi_approx;
+}
+
+// Cada método soma termos até |π - aproximação| <= tol e devolve o número de termos usados
+// (ou -1 se não chegou lá). A aproximação final fica em *result.
+
+long leibniz_to_tol(double tol, double *result){
+  double sum = 0.0;
+  for (long k = 0; k < LEIBNIZ_MAX_TERMS; k++){
+    sum += (k % 2 == 0 ? 1.0 : -1.0) / (2 * k + 1);
+    if (fabs(4.0 * sum - M_PI) <= tol){
+      *result = 4.0 * sum;
+      return k + 1;
+    }
+  }
+  *result = 4.0 * sum;
+  return -1;
+}
+
+// t_0 = 1, t_k = t_{k-1} * k / (2k+1);  π = 2 Σ t_k
+long euler_to_tol(double tol, double *result){
+  double term = 1.0, sum = 1.0;
+  for (long k = 1; k < 200; k++){
+    term *= (double)k / (2.0 * k + 1.0);
+    sum += term;
+    if (fabs(2.0 * sum - M_PI) <= tol){
+      *result = 2.0 * sum;
+      return k + 1;
+    }
+  }
+  *result = 2.0 * sum;
+  return -1;
+}
+
+// Para n par, π/4 - S_n = 1/(4n) - 1/(16n^3) + ...: só potências ímpares de 1/n. Com as somas
+// S_n, S_2n, S_4n, ... a tabela de Richardson elimina 1/n, 1/n^3, 1/n^5, ... um nível por vez.
+long richardson_to_tol(double tol, double *result){
+  double table[RICHARDSON_MAX_LEVELS][RICHARDSON_MAX_LEVELS];
+  double sum = 0.0;
+  long terms = 0;
+
+  for (int level = 0; level < RICHARDSON_MAX_LEVELS; level++){
+    long target = (long)RICHARDSON_BASE << level;
+    for (; terms < target; terms++){ // Reaproveita a soma parcial anterior
+      sum += (terms % 2 == 0 ? 1.0 : -1.0) / (2 * terms + 1);
+    }
+    table[level][0] = 4.0 * sum;
+
+    double factor = 2.0; // 2^p, com p = 1, 3, 5, ...
+    for (int j = 1; j <= level; j++){
+      table[level][j] = (factor * table[level][j - 1] - table[level - 1][j - 1]) / (factor - 1.0);
+      factor *= 4.0;
+    }
+
+    if (fabs(table[level][level] - M_PI) <= tol){
+      *result = table[level][level];
+      return terms;
+    }
+  }
+  *result = table[RICHARDSON_MAX_LEVELS - 1][RICHARDSON_MAX_LEVELS - 1];
+  return -1;
+}
+
+// arctan(1/x) = Σ (-1)^k / ((2k+1) x^(2k+1)); as duas séries andam juntas
+long machin_to_tol(double tol, double *result){
+  double pow5 = 1.0 / 5.0, pow239 = 1.0 / 239.0;
+  double atan5 = 0.0, atan239 = 0.0;
+  for (long k = 0; k < 100; k++){
+    double sign = k % 2 == 0 ? 1.0 : -1.0;
+    atan5 += sign * pow5 / (2 * k + 1);
+    atan239 += sign * pow239 / (2 * k + 1);
+    pow5 /= 25.0;
+    pow239 /= 239.0 * 239.0;
+    double approx = 16.0 * atan5 - 4.0 * atan239;
+    if (fabs(approx - M_PI) <= tol){
+      *result = approx;
+      return k + 1;
+    }
+  }
+  *result = 16.0 * atan5 - 4.0 * atan239;
+  return -1;
+}
+
+long bbp_to_tol(double tol, double *result){
+  double sum = 0.0, scale = 1.0;
+  for (long k = 0; k < 100; k++){
+    double k8 = 8.0 * k;
+    sum += scale * (4.0 / (k8 + 1) - 2.0 / (k8 + 4) - 1.0 / (k8 + 5) - 1.0 / (k8 + 6));
+    scale /= 16.0;
+    if (fabs(sum - M_PI) <= tol){
+      *result = sum;
+      return k + 1;
+    }
+  }
+  *result = sum;
+  return -1;
+}
+
+// --- Extração de dígitos hexadecimais (algoritmo BBP) ---
+
+// 16^p mod m por exponenciação binária. Em inteiros: com double, result * base só é exato
+// enquanto m^2 < 2^53 (posições até ~10^7); o produto em 128 bits vale para qualquer m de 64 bits.
+uint64_t pow16_mod(long p, uint64_t m){
+  if (m == 1) return 0;
+  uint64_t result = 1, base = 16 % m;
+  while (p > 0){
+    if (p & 1) result = (unsigned __int128)result * base % m;
+    base = (unsigned __int128)base * base % m;
+    p >>= 1;
+  }
+  return result;
+}
+
+// Parte fracionária de Σ_k 16^(d-k) / (8k+j)
+double bbp_series(int j, long d){
+  double s = 0.0;
+  for (long k = 0; k < d; k++){ // Parte com expoente positivo, reduzida módulo (8k+j)
+    uint64_t denom = 8 * (uint64_t)k + j;
+    s += (double)pow16_mod(d - k, denom) / (double)denom;
+    s -= floor(s);
+  }
+  for (long k = d; k <= d + 100; k++){ // Cauda, que cai rápido
+    double t = pow(16.0, (double)(d - k)) / (8.0 * k + j);
+    if (t < 1e-17) break;
+    s += t;
+    s -= floor(s);
+  }
+  return s;
+}
+
+// Escreve em digits os n_digits dígitos hexadecimais de π a partir da posição d+1 após a vírgula
+// (a soma em double acumula ~d ulps, então os últimos dígitos perdem confiança para d >~ 10^10)
+void bbp_hex_digits(long d, int n_digits, char *digits){
+  static const char hex[] = "0123456789ABCDEF";
+  double x = 4.0 * bbp_series(1, d) - 2.0 * bbp_series(4, d) - bbp_series(5, d) - bbp_series(6, d);
+  x -= floor(x);
+  for (int i = 0; i < n_digits; i++){
+    x *= 16.0;
+    int digit = (int)x;
+    digits[i] = hex[digit];
+    x -= digit;
+  }
+  digits[n_digits] = '\0';
+}
+
+double elapsed_seconds(struct timeval start, struct timeval end){
+  return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+}
+
+int main(int argc, char *argv[]){
+  if (argc < 2 || argc > 4){
+    printf("Uso: %s <número de iterações> [tolerância] [posição hexadecimal]\n", argv[0]);
+    return 1;
+  }
+
+  long iterations = atol(argv[1]);
+  double tol = argc > 2 ? atof(argv[2]) : 1e-10;
+  long hex_position = argc > 3 ? atol(argv[3]) : 100000;
+
+  if (iterations <= 0 || tol <= 0.0 || hex_position < 0){
+    printf("Iterações e tolerância devem ser positivas e a posição não pode ser negativa\n");
+    return 1;
+  }
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  double PI = leibniz_pi(iterations);
+  gettimeofday(&end, NULL);
+
+  double elapsed_time = elapsed_seconds(start, end);
+  printf("Tempo de execução da série: %f segundos\n", elapsed_time);
+  printf("π calculado= %.15f\n", PI);
+  printf("Valor real de π: %.15f\n", M_PI);
+  printf("Erro absoluto: %.15f\n", fabs(M_PI - PI));
+
+  // --- Tempo até a tolerância ---
+  typedef long (*method_fn)(double, double *);
+  const char *names[] = {"Leibniz", "Euler", "Richardson", "Machin", "BBP"};
+  method_fn methods[] = {leibniz_to_tol, euler_to_tol, richardson_to_tol, machin_to_tol, bbp_to_tol};
+
+  printf("\nTolerância: %.1e\n", tol);
+  printf("%-12s %14s %14s %20s %12s\n", "método", "termos", "tempo (s)", "π calculado", "erro");
+  for (int m = 0; m < 5; m++){
+    double approx;
+    gettimeofday(&start, NULL);
+    long terms = methods[m](tol, &approx);
+    gettimeofday(&end, NULL);
+
+    if (terms < 0)
+      printf("%-12s %14s %14f %20.15f %12.3e (não atingiu)\n", names[m], "-",
+             elapsed_seconds(start, end), approx, fabs(M_PI - approx));
+    else
+      printf("%-12s %14ld %14f %20.15f %12.3e\n", names[m], terms,
+             elapsed_seconds(start, end), approx, fabs(M_PI - approx));
+  }
+
+  // --- Dígitos hexadecimais numa posição qualquer ---
+  char digits[9];
+  gettimeofday(&start, NULL);
+  bbp_hex_digits(hex_position, 8, digits);
+  gettimeofday(&end, NULL);
+  printf("\nDígitos hexadecimais de π a partir da posição %ld: %s (%f segundos)\n",
+         hex_position + 1, digits, elapsed_seconds(start, end));
+
+  return 0;
+}
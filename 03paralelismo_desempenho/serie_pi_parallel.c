@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <math.h>
+#include <omp.h>
+
+// Série de Leibniz vetorizada, paralela e reprodutível bit a bit.
+// Os termos são somados em pares: 1/(4m+1) - 1/(4m+3) = 2 / ((4m+1)(4m+3)), o que elimina o
+// módulo e deixa uma divisão para cada dois termos, num laço sem desvios que vetoriza.
+// O intervalo de índices é cortado em blocos de tamanho fixo (não depende do número de threads);
+// cada bloco vira uma soma parcial, e as parciais são combinadas por soma em pares (pairwise),
+// sempre na mesma ordem. Por isso o resultado é o mesmo com 1 ou 64 threads.
+// A série original, só para comparação de tempo, roda no máximo SEQ_MAX_TERMS termos; acima disso
+// o tempo dela é extrapolado linearmente (o custo por termo é constante).
+// Compilar com: gcc -O3 -march=native -fopenmp serie_pi_parallel.c -o serie_pi_parallel -lm
+// Uso: ./serie_pi_parallel <número de iterações> [número de threads]
+
+#define BLOCK_PAIRS (1L << 20) // Pares de termos por bloco
+#define SEQ_MAX_TERMS 100000000L // Termos da série original medidos de fato
+
+double leibniz_pi(long n_terms){ // Versão original, para comparação de tempo
+  double pi_approx = 0.0;
+  for (long k = 0; k < n_terms; k++){
+    pi_approx += (k % 2 == 0 ? 1.0 : -1.0) / (2 * k + 1);
+  }
+  return 4 * pi_approx;
+}
+
+// Soma dos pares [first, last) de um bloco
+double block_sum(long first, long last){
+  double sum = 0.0;
+  #pragma omp simd reduction(+ : sum)
+  for (long m = first; m < last; m++){
+    double a = 4.0 * (double)m;
+    sum += 2.0 / ((a + 1.0) * (a + 3.0));
+  }
+  return sum;
+}
+
+// Soma em pares: erro O(log n) em vez de O(n), e ordem fixa
+double pairwise_sum(const double *values, long n){
+  if (n <= 8){
+    double sum = 0.0;
+    for (long i = 0; i < n; i++) sum += values[i];
+    return sum;
+  }
+  long half = n / 2;
+  return pairwise_sum(values, half) + pairwise_sum(values + half, n - half);
+}
+
+double leibniz_pi_parallel(long n_terms){
+  long pairs = n_terms / 2;
+  long n_blocks = (pairs + BLOCK_PAIRS - 1) / BLOCK_PAIRS;
+  double *partial = malloc(sizeof(double) * (n_blocks > 0 ? n_blocks : 1));
+  if (partial == NULL) return NAN;
+
+  #pragma omp parallel for schedule(static)
+  for (long b = 0; b < n_blocks; b++){
+    long first = b * BLOCK_PAIRS;
+    long last = first + BLOCK_PAIRS < pairs ? first + BLOCK_PAIRS : pairs;
+    partial[b] = block_sum(first, last);
+  }
+
+  double sum = pairwise_sum(partial, n_blocks);
+  if (n_terms % 2 == 1) sum += 1.0 / (2.0 * (double)(n_terms - 1) + 1.0); // Último termo sem par (k par: positivo)
+
+  free(partial);
+  return 4.0 * sum;
+}
+
+int main(int argc, char *argv[]){
+  if (argc != 2 && argc != 3){
+    printf("Uso: %s <número de iterações> [número de threads]\n", argv[0]);
+    return 1;
+  }
+
+  long iterations = atol(argv[1]);
+  if (iterations <= 0){
+    printf("O número de iterações deve ser positivo\n");
+    return 1;
+  }
+  if (argc == 3) omp_set_num_threads(atoi(argv[2]));
+
+  long seq_terms = iterations < SEQ_MAX_TERMS ? iterations : SEQ_MAX_TERMS;
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  double PI_seq = leibniz_pi(seq_terms);
+  gettimeofday(&end, NULL);
+  double seq_time = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+  seq_time *= (double)iterations / seq_terms; // Extrapolação quando a série foi cortada
+
+  gettimeofday(&start, NULL);
+  double PI = leibniz_pi_parallel(iterations);
+  gettimeofday(&end, NULL);
+  double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+
+  if (seq_terms == iterations)
+    printf("Tempo de execução da série original: %f segundos (%.3e termos/s)\n", seq_time, iterations / seq_time);
+  else
+    printf("Tempo de execução da série original: %f segundos (%.3e termos/s, estimado com %ld termos)\n",
+           seq_time, iterations / seq_time, seq_terms);
+  printf("Tempo de execução da série paralela (%d threads): %f segundos (%.3e termos/s, %.1fx)\n",
+         omp_get_max_threads(), elapsed_time, iterations / elapsed_time, seq_time / elapsed_time);
+  if (seq_terms == iterations)
+    printf("π calculado (original)= %.15f\n", PI_seq);
+  printf("π calculado (paralelo)= %.15f  [%a]\n", PI, PI); // Hexadecimal: compara bits entre execuções
+  printf("Valor real de π: %.15f\n", M_PI);
+  if (seq_terms == iterations)
+    printf("Erro absoluto (original): %.15f\n", fabs(M_PI - PI_seq));
+  printf("Erro absoluto (paralelo): %.15f\n", fabs(M_PI - PI));
+
+  return 0;
+}
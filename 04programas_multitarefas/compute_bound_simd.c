@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <math.h>
+#include <float.h>
+#include <omp.h>
+#include "poly_math.h"
+
+// Versão correta e vetorizada de calculos_complexos (compute_bound.c).
+// O original soma em "sum" compartilhado sem reduction (condição de corrida), devolve o double
+// por um int e, para i > 170, tgamma(i+1) e depois exp(i) estouram: a soma vira inf. Aqui o
+// argumento é x = 1 + i/n, em [1, 2), e a mesma expressão é calculada por três backends:
+//   libm:    chamadas escalares de sin/cos/tan/log/exp/tgamma, com reduction (referência)
+//   libmvec: as mesmas chamadas num laço "omp simd"; com -ffast-math a glibc declara as versões
+//            vetoriais (_ZGVdN4v_sin, _ZGVeN8v_tan etc.). tgamma não tem versão vetorial e vira
+//            Stirling. cos(x) é escrito como sin(x + pi/2): com sin(x) e cos(x) do mesmo x o GCC
+//            funde os dois num sincos escalar, e o laço inteiro deixa de vetorizar. Para conferir:
+//            objdump -d compute_bound_simd | grep _ZGV
+//   poly:    aproximações polinomiais próprias, sem chamadas; POLY_TERMS controla o número de
+//            termos de cada série e, com ele, o erro em ULP e o custo.
+// O erro de cada backend é medido em ULP contra a referência, com os valores calculados pelo mesmo
+// laço vetorizado do kernel. Só poly, cujo erro depende de POLY_TERMS, é comparado com o máximo.
+// A vazão é dada em GFLOP-equivalentes: o número de operações de ponto flutuante do backend
+// poly (contadas em poly_math.h) vale como unidade de trabalho por elemento para os três.
+// Compilar com: gcc -O3 -march=native -ffast-math -fopenmp compute_bound_simd.c -o compute_bound_simd -lm
+// Uso: ./compute_bound_simd <número de iterações> [número de threads] [ULP máximo]
+
+#define ULP_SAMPLES 100000 // Pontos usados para medir o erro
+#define ELEMENT_FLOPS (POLY_ELEMENT_FLOPS + 2) // + cálculo de x = 1 + i h
+
+DEFINE_STIRLING_GAMMA(stirling_tgamma, exp, log)
+
+// --- Expressão de calculos_complexos em cada backend ---
+
+static double element_libm(double x){
+  return tan(sin(x) + cos(x)) + sqrt(x) + log(x) + exp(x) + pow(x, 2) + tgamma(x + 1);
+}
+
+// Inline no laço "omp simd": as chamadas de sin/tan/log/exp viram as versões vetoriais
+static inline double element_libmvec(double x){
+  return tan(sin(x) + sin(x + M_PI_2)) + sqrt(x) + log(x) + exp(x) + x * x + stirling_tgamma(x + 1);
+}
+
+// --- Kernels ---
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define NOVEC __attribute__((optimize("no-tree-vectorize")))
+#else
+#define NOVEC
+#endif
+
+// A referência fica escalar de propósito: sem isso, com -ffast-math, o GCC também usaria a libmvec
+static NOVEC double calculos_complexos_libm(long iterations){
+  double sum = 0.0, h = 1.0 / iterations;
+
+  #pragma omp parallel for schedule(static) reduction(+ : sum)
+  for (long i = 0; i < iterations; i++){
+    sum += element_libm(1.0 + i * h);
+  }
+
+  return sum;
+}
+
+static double calculos_complexos_libmvec(long iterations){
+  double sum = 0.0, h = 1.0 / iterations;
+
+  #pragma omp parallel for simd schedule(static) reduction(+ : sum)
+  for (long i = 0; i < iterations; i++){
+    sum += element_libmvec(1.0 + i * h);
+  }
+
+  return sum;
+}
+
+static double calculos_complexos_poly(long iterations){
+  double sum = 0.0, h = 1.0 / iterations;
+
+  #pragma omp parallel for simd schedule(static) reduction(+ : sum)
+  for (long i = 0; i < iterations; i++){
+    sum += element_poly(1.0 + i * h);
+  }
+
+  return sum;
+}
+
+// --- Erro em ULP ---
+
+static NOVEC double ulp_error(double value, double reference){
+  double ulp = ldexp(1.0, ilogb(reference) - (DBL_MANT_DIG - 1)); // Espaçamento dos doubles em reference
+  return fabs(value - reference) / ulp;
+}
+
+// Valores de cada backend em ULP_SAMPLES pontos de [1, 2), em laços "omp simd" como os kernels
+static void sample_libmvec(const double *x, double *out){
+  #pragma omp simd
+  for (int s = 0; s < ULP_SAMPLES; s++) out[s] = element_libmvec(x[s]);
+}
+
+static void sample_poly(const double *x, double *out){
+  #pragma omp simd
+  for (int s = 0; s < ULP_SAMPLES; s++) out[s] = element_poly(x[s]);
+}
+
+// Maior erro, em ULP, dos valores de um backend contra element_libm
+static NOVEC double measured_ulp(void (*sample)(const double *, double *)){
+  static double x[ULP_SAMPLES], value[ULP_SAMPLES];
+  for (int s = 0; s < ULP_SAMPLES; s++) x[s] = 1.0 + (double)s / ULP_SAMPLES;
+  sample(x, value);
+
+  double worst = 0.0;
+  for (int s = 0; s < ULP_SAMPLES; s++){
+    double err = ulp_error(value[s], element_libm(x[s]));
+    if (err > worst) worst = err;
+  }
+  return worst;
+}
+
+int main(int argc, char *argv[]){
+  if (argc < 2 || argc > 4){
+    printf("Uso: %s <número de iterações> [número de threads] [ULP máximo]\n", argv[0]);
+    return 1;
+  }
+
+  long iterations = atol(argv[1]);
+  double max_ulp = argc > 3 ? atof(argv[3]) : 64.0;
+  if (iterations <= 0 || max_ulp <= 0.0){
+    printf("Iterações e ULP máximo devem ser positivos\n");
+    return 1;
+  }
+  if (argc > 2) omp_set_num_threads(atoi(argv[2]));
+
+  typedef double (*kernel_fn)(long);
+  const char *names[] = {"libm", "libmvec", "poly"};
+  kernel_fn kernels[] = {calculos_complexos_libm, calculos_complexos_libmvec, calculos_complexos_poly};
+  double ulp[] = {0.0, measured_ulp(sample_libmvec), measured_ulp(sample_poly)};
+
+  printf("Threads: %d, termos por série: %d, FLOP-equivalentes por elemento: %d\n",
+         omp_get_max_threads(), POLY_TERMS, ELEMENT_FLOPS);
+  printf("%-8s %14s %14s %14s %24s %10s\n", "backend", "tempo (s)", "GFLOP-eq/s", "speedup", "soma", "ULP");
+
+  double base_time = 0.0;
+  for (int b = 0; b < 3; b++){
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    double result = kernels[b](iterations);
+    gettimeofday(&end, NULL);
+
+    double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+    if (b == 0) base_time = elapsed_time;
+
+    printf("%-8s %14f %14.3f %13.2fx %24.15e %10.1f%s\n", names[b], elapsed_time,
+           (double)ELEMENT_FLOPS * iterations / elapsed_time / 1e9, base_time / elapsed_time, result,
+           ulp[b], b < 2 || ulp[b] <= max_ulp ? "" : " (acima do máximo)");
+  }
+
+  return 0;
+}
@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include <immintrin.h>
+
+// Suíte de banda de memória no estilo STREAM, no lugar da medida única de soma_vetores (memory_bound.c).
+// Kernels (bytes contados por elemento, como no STREAM):
+//   copy   c = a              16
+//   scale  b = s c            16
+//   add    c = a + b          24
+//   triad  a = b + s c        24
+//   soma4  a = b + c + d      32  (a soma de 4 operandos de soma_vetores, em double)
+// Cada kernel tem uma versão com stores normais e outra com stores não temporais (streaming), que
+// escrevem direto na memória sem ler a linha antes (sem o write-allocate) e sem sujar a cache
+// (coluna "stores": NT).
+// Para cada número de threads os vetores são alocados de novo e preenchidos em paralelo com a mesma
+// divisão usada nos kernels (primeiro toque). Há WARMUP passadas descartadas e depois REPETITIONS
+// passadas medidas; o relatório dá a banda na melhor e na mediana, e os resultados são conferidos.
+// Compilar com: gcc -O3 -march=native -fopenmp memory_bound_stream.c -o memory_bound_stream -lm
+// Uso: ./memory_bound_stream <tamanho do vetor> [número máximo de threads]
+// O vetor deve ser bem maior que o último nível de cache (o STREAM pede 4x).
+
+#define WARMUP 2
+#define REPETITIONS 10
+#define ALIGNMENT 64
+#define SCALAR 3.0
+#define N_KERNELS 5
+
+#if defined(__AVX512F__)
+#define ISA_NAME "AVX-512"
+#define VEC 8
+typedef __m512d vd;
+#define VLOAD _mm512_load_pd
+#define VSTREAM _mm512_stream_pd
+#define VADD _mm512_add_pd
+#define VMUL _mm512_mul_pd
+#define VSET1 _mm512_set1_pd
+#elif defined(__AVX__)
+#define ISA_NAME "AVX"
+#define VEC 4
+typedef __m256d vd;
+#define VLOAD _mm256_load_pd
+#define VSTREAM _mm256_stream_pd
+#define VADD _mm256_add_pd
+#define VMUL _mm256_mul_pd
+#define VSET1 _mm256_set1_pd
+#else
+#define ISA_NAME "SSE2"
+#define VEC 2
+typedef __m128d vd;
+#define VLOAD _mm_load_pd
+#define VSTREAM _mm_stream_pd
+#define VADD _mm_add_pd
+#define VMUL _mm_mul_pd
+#define VSET1 _mm_set1_pd
+#endif
+
+enum { COPY, SCALE, ADD, TRIAD, SOMA4 };
+static const char *kernel_names[N_KERNELS] = {"copy", "scale", "add", "triad", "soma4"};
+static const double kernel_bytes[N_KERNELS] = {16, 16, 24, 24, 32};
+
+void *alignedAlloc(size_t bytes) {
+  size_t rounded = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; // aligned_alloc exige múltiplo do alinhamento
+  return aligned_alloc(ALIGNMENT, rounded);
+}
+
+// Intervalo [start, end) da thread tid, com início múltiplo de uma linha de cache: cada thread
+// começa alinhada (loads e stores não temporais alinhados) e nenhuma linha é dividida entre threads.
+// A mesma divisão é usada no preenchimento e nos kernels.
+void threadRange(long n, int tid, int nthreads, long *start, long *end) {
+  const long line = ALIGNMENT / sizeof(double);
+  long lines = (n + line - 1) / line;
+  long base = lines / nthreads, rest = lines % nthreads;
+  long first = tid * base + (tid < rest ? tid : rest);
+  long count = base + (tid < rest ? 1 : 0);
+  *start = first * line < n ? first * line : n;
+  *end = (first + count) * line < n ? (first + count) * line : n;
+}
+
+void fillVectors(long n, double *a, double *b, double *c, double *d) {
+  #pragma omp parallel
+  {
+    long start, end;
+    threadRange(n, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+    for (long i = start; i < end; i++){
+      a[i] = 1.0;
+      b[i] = 2.0;
+      c[i] = 0.0;
+      d[i] = 1.0;
+    }
+  }
+}
+
+// Kernels com stores normais: o compilador vetoriza
+void runKernel(int kernel, long n, double *a, double *b, double *c, const double *d) {
+  #pragma omp parallel
+  {
+    long start, end;
+    threadRange(n, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+    switch (kernel){
+      case COPY:
+        #pragma omp simd
+        for (long i = start; i < end; i++) c[i] = a[i];
+        break;
+      case SCALE:
+        #pragma omp simd
+        for (long i = start; i < end; i++) b[i] = SCALAR * c[i];
+        break;
+      case ADD:
+        #pragma omp simd
+        for (long i = start; i < end; i++) c[i] = a[i] + b[i];
+        break;
+      case TRIAD:
+        #pragma omp simd
+        for (long i = start; i < end; i++) a[i] = b[i] + SCALAR * c[i];
+        break;
+      case SOMA4:
+        #pragma omp simd
+        for (long i = start; i < end; i++) a[i] = b[i] + c[i] + d[i];
+        break;
+    }
+  }
+}
+
+// Kernels com stores não temporais; o resto que não completa um vetor SIMD vai com store normal
+void runKernelNT(int kernel, long n, double *a, double *b, double *c, const double *d) {
+  #pragma omp parallel
+  {
+    long start, end;
+    threadRange(n, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+    long vend = start + (end - start) / VEC * VEC;
+    vd s = VSET1(SCALAR);
+    long i;
+    switch (kernel){
+      case COPY:
+        for (i = start; i < vend; i += VEC) VSTREAM(c + i, VLOAD(a + i));
+        for (; i < end; i++) c[i] = a[i];
+        break;
+      case SCALE:
+        for (i = start; i < vend; i += VEC) VSTREAM(b + i, VMUL(s, VLOAD(c + i)));
+        for (; i < end; i++) b[i] = SCALAR * c[i];
+        break;
+      case ADD:
+        for (i = start; i < vend; i += VEC) VSTREAM(c + i, VADD(VLOAD(a + i), VLOAD(b + i)));
+        for (; i < end; i++) c[i] = a[i] + b[i];
+        break;
+      case TRIAD:
+        for (i = start; i < vend; i += VEC) VSTREAM(a + i, VADD(VLOAD(b + i), VMUL(s, VLOAD(c + i))));
+        for (; i < end; i++) a[i] = b[i] + SCALAR * c[i];
+        break;
+      case SOMA4:
+        for (i = start; i < vend; i += VEC) VSTREAM(a + i, VADD(VADD(VLOAD(b + i), VLOAD(c + i)), VLOAD(d + i)));
+        for (; i < end; i++) a[i] = b[i] + c[i] + d[i];
+        break;
+    }
+    _mm_sfence(); // Stores não temporais não são ordenados: garante que terminaram antes da barreira
+  }
+}
+
+int compareDouble(const void *x, const void *y) {
+  double a = *(const double *)x, b = *(const double *)y;
+  return (a > b) - (a < b);
+}
+
+// Repete a sequência de kernels sobre os escalares, como o STREAM faz, e confere os vetores
+int checkVectors(long n, int passes, const double *a, const double *b, const double *c) {
+  double aj = 1.0, bj = 2.0, cj = 0.0, dj = 1.0;
+  for (int p = 0; p < passes; p++){
+    cj = aj;
+    bj = SCALAR * cj;
+    cj = aj + bj;
+    aj = bj + SCALAR * cj;
+    aj = bj + cj + dj;
+  }
+  double max_err = 0.0;
+  for (long i = 0; i < n; i++){
+    max_err = fmax(max_err, fabs(a[i] - aj) / aj);
+    max_err = fmax(max_err, fabs(b[i] - bj) / bj);
+    max_err = fmax(max_err, fabs(c[i] - cj) / cj);
+  }
+  return max_err < 1e-13;
+}
+
+// Mede todos os kernels, normais e não temporais, com nthreads threads
+int benchmark(long n, int nthreads) {
+  double *a = alignedAlloc(sizeof(double) * n);
+  double *b = alignedAlloc(sizeof(double) * n);
+  double *c = alignedAlloc(sizeof(double) * n);
+  double *d = alignedAlloc(sizeof(double) * n);
+  if (!a || !b || !c || !d){
+    printf("Memória insuficiente para %ld elementos\n", n);
+    free(a); free(b); free(c); free(d);
+    return 0;
+  }
+
+  omp_set_num_threads(nthreads);
+  fillVectors(n, a, b, c, d);
+
+  double times[2][N_KERNELS][REPETITIONS];
+  int passes = 0;
+  for (int nt = 0; nt < 2; nt++){
+    for (int rep = 0; rep < WARMUP + REPETITIONS; rep++, passes++){
+      for (int k = 0; k < N_KERNELS; k++){
+        double t0 = omp_get_wtime();
+        if (nt) runKernelNT(k, n, a, b, c, d);
+        else runKernel(k, n, a, b, c, d);
+        double t = omp_get_wtime() - t0;
+        if (rep >= WARMUP) times[nt][k][rep - WARMUP] = t;
+      }
+    }
+  }
+
+  int ok = checkVectors(n, passes, a, b, c);
+  for (int nt = 0; nt < 2; nt++){
+    for (int k = 0; k < N_KERNELS; k++){
+      qsort(times[nt][k], REPETITIONS, sizeof(double), compareDouble);
+      double bytes = kernel_bytes[k] * n;
+      printf("%7d %-6s %-7s %12.2f %12.2f %12.6f\n", nthreads, kernel_names[k],
+             nt ? "NT" : "normal", bytes / times[nt][k][0] / 1e9,
+             bytes / times[nt][k][REPETITIONS / 2] / 1e9, times[nt][k][0]);
+    }
+  }
+  if (!ok) printf("ERRO: resultados incorretos com %d threads\n", nthreads);
+
+  free(a); free(b); free(c); free(d);
+  return ok;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc != 2 && argc != 3){
+    printf("Uso: %s <tamanho do vetor> [número máximo de threads]\n", argv[0]);
+    return 1;
+  }
+
+  long n = atol(argv[1]);
+  int max_threads = argc == 3 ? atoi(argv[2]) : omp_get_max_threads();
+  if (n <= 0 || max_threads <= 0){
+    printf("Tamanho do vetor e número de threads devem ser positivos\n");
+    return 1;
+  }
+
+  printf("Vetor: %ld elementos (%.1f MB cada), stores não temporais: %s\n", n, 8.0 * n / 1e6, ISA_NAME);
+  printf("%7s %-6s %-7s %12s %12s %12s\n", "threads", "kernel", "stores", "melhor GB/s",
+         "mediana GB/s", "melhor (s)");
+
+  // 1, 2, 4, ... e o máximo pedido
+  int ok = 1;
+  for (int t = 1; ; t *= 2){
+    int threads = t < max_threads ? t : max_threads;
+    ok &= benchmark(n, threads);
+    if (threads == max_threads) break;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+#ifndef POLY_MATH_H
+#define POLY_MATH_H
+
+// Aproximações polinomiais de sin, cos, exp, log e Γ que vetorizam (omp declare simd), sem
+// chamadas à libm. POLY_TERMS controla o número de termos de cada série e, com ele, erro e custo.
+// Também conta as operações de ponto flutuante de cada função, usadas como unidade de trabalho
+// (FLOP-equivalentes) por compute_bound_simd.c e roofline.c.
+// Requer -lm.
+
+#include <string.h>
+#include <math.h>
+
+#ifndef POLY_TERMS
+#define POLY_TERMS 13 // Termos de cada série de Taylor (sin, cos, exp, log)
+#endif
+
+#define GAMMA_SHIFT 16 // Γ(z) = Γ(z + 16) / (z (z+1) ... (z+15)), com Stirling em z + 16 >= 18
+
+#define LOG2E 1.4426950408889634
+#define LN2_HI 6.93147180369123816490e-01 // ln 2 dividido em duas partes para a redução de exp
+#define LN2_LO 1.90821492927058770002e-10
+#define HALF_LOG_2PI 0.91893853320467274178
+
+// Operações de ponto flutuante de cada função do backend poly
+#define SIN_FLOPS (3 * POLY_TERMS - 1)
+#define COS_FLOPS (3 * POLY_TERMS - 2)
+#define EXP_FLOPS (3 * POLY_TERMS + 7)
+#define LOG_FLOPS (2 * POLY_TERMS + 9)
+#define GAMMA_FLOPS (2 * (GAMMA_SHIFT - 1) + 18 + LOG_FLOPS + EXP_FLOPS)
+
+// --- Backend poly ---
+
+// sin a = a (1 - a²/(2·3) (1 - a²/(4·5) (1 - ...))); |a| <= 2 no domínio usado, sem redução
+#pragma omp declare simd notinbranch
+static inline double poly_sin(double a){
+  double a2 = a * a, r = 1.0;
+  #pragma GCC unroll 32
+  for (int k = POLY_TERMS - 1; k >= 1; k--) r = 1.0 - a2 * (1.0 / ((2.0 * k) * (2.0 * k + 1.0))) * r;
+  return a * r;
+}
+
+// cos a = 1 - a²/(1·2) (1 - a²/(3·4) (1 - ...))
+#pragma omp declare simd notinbranch
+static inline double poly_cos(double a){
+  double a2 = a * a, r = 1.0;
+  #pragma GCC unroll 32
+  for (int k = POLY_TERMS - 1; k >= 1; k--) r = 1.0 - a2 * (1.0 / ((2.0 * k - 1.0) * (2.0 * k))) * r;
+  return r;
+}
+
+// e^x = 2^k e^r, com k = round(x / ln 2) e |r| <= ln2 / 2; 2^k montado direto nos bits do expoente
+#pragma omp declare simd notinbranch
+static inline double poly_exp(double x){
+  double k = floor(x * LOG2E + 0.5);
+  double r = x - k * LN2_HI - k * LN2_LO;
+  double p = 1.0;
+  #pragma GCC unroll 32
+  for (int j = POLY_TERMS; j >= 1; j--) p = 1.0 + r * (1.0 / j) * p;
+  long bits = ((long)k + 1023) << 52;
+  double scale;
+  memcpy(&scale, &bits, sizeof scale);
+  return p * scale;
+}
+
+// log x = e ln 2 + 2 atanh(s), s = (m - 1)/(m + 1), com a mantissa m em [√2/2, √2) e |s| <= 0.172
+#pragma omp declare simd notinbranch
+static inline double poly_log(double x){
+  long bits;
+  memcpy(&bits, &x, sizeof bits);
+  double e = (double)((bits >> 52) - 1023);
+  long mbits = (bits & 0x000FFFFFFFFFFFFFL) | 0x3FF0000000000000L;
+  double m;
+  memcpy(&m, &mbits, sizeof m);
+  int big = m > M_SQRT2;
+  m = big ? m * 0.5 : m;
+  e = big ? e + 1.0 : e;
+
+  double s = (m - 1.0) / (m + 1.0), s2 = s * s, r = 1.0 / (2 * POLY_TERMS - 1);
+  #pragma GCC unroll 32
+  for (int k = POLY_TERMS - 2; k >= 0; k--) r = 1.0 / (2 * k + 1) + s2 * r;
+  return e * LN2_HI + (2.0 * s * r + e * LN2_LO);
+}
+
+// Γ(z) para z > 0 moderado: desloca z por GAMMA_SHIFT e usa a série de Stirling em w = z + GAMMA_SHIFT.
+// O mesmo cálculo serve aos dois backends vetoriais, mudando só exp e log.
+#define DEFINE_STIRLING_GAMMA(NAME, EXP, LOG)                                              \
+  _Pragma("omp declare simd notinbranch")                                                 \
+  static inline double NAME(double z){                                                    \
+    double p = z;                                                                         \
+    _Pragma("GCC unroll 32")                                                              \
+    for (int i = 1; i < GAMMA_SHIFT; i++) p *= z + i;                                     \
+    double w = z + GAMMA_SHIFT, iw = 1.0 / w, iw2 = iw * iw;                              \
+    double corr = iw * (1.0 / 12 + iw2 * (-1.0 / 360 + iw2 * (1.0 / 1260 + iw2 * (-1.0 / 1680 \
+                  + iw2 * (1.0 / 1188)))));                                               \
+    double lg = (w - 0.5) * LOG(w) - w + HALF_LOG_2PI + corr;                             \
+    return EXP(lg) / p;                                                                   \
+  }
+
+DEFINE_STIRLING_GAMMA(poly_tgamma, poly_exp, poly_log)
+
+// A expressão de calculos_complexos (compute_bound.c) com o backend poly
+#define POLY_ELEMENT_FLOPS (2 * (SIN_FLOPS + COS_FLOPS) + 2 + 1 + LOG_FLOPS + EXP_FLOPS + 1 + 1 + GAMMA_FLOPS + 5)
+
+#pragma omp declare simd notinbranch
+static inline double element_poly(double x){
+  double t = poly_sin(x) + poly_cos(x);
+  return poly_sin(t) / poly_cos(t) + sqrt(x) + poly_log(x) + poly_exp(x) + x * x + poly_tgamma(x + 1);
+}
+
+#endif
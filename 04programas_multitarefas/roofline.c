@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <math.h>
+#include <omp.h>
+#include "poly_math.h"
+
+// Modelo roofline para os kernels de compute_bound.c e memory_bound.c.
+// 1. Mede os tetos da máquina: banda de memória, a maior entre triad (a[i] = b[i] + s c[i], 24 bytes
+//    por elemento, sem contar a leitura extra do write-allocate) e atualização no lugar (v[i] = s v[i],
+//    16 bytes), e FLOP/s de pico (cadeias independentes de FMA que ficam nos registradores).
+// 2. Varre a intensidade aritmética (FLOP/byte) com um kernel que lê e escreve um vetor (16 bytes
+//    por elemento) e aplica K FMAs em cada elemento: I = 2K / 16. Com K pequeno o kernel é limitado
+//    pela memória; com K grande, pelo processamento. O "joelho" fica em I = pico FLOP/s / banda.
+// 3. Coloca no gráfico os dois kernels originais, corrigidos (reduction e vetores grandes):
+//    soma_vetores (memory_bound.c, 2 somas de int e 16 bytes por elemento) e calculos_complexos
+//    (compute_bound.c, backend poly de poly_math.h, lendo x de um vetor: 8 bytes por elemento).
+// Para cada ponto imprime FLOP/s, bytes/s, o teto atingível min(pico, I x banda) e quanto dele
+// foi alcançado. Com um arquivo na linha de comando, exporta tudo em CSV para plotar.
+// Compilar com: gcc -O3 -march=native -ffast-math -fopenmp roofline.c -o roofline -lm
+// Uso: ./roofline <tamanho do vetor> [número de threads] [arquivo CSV]
+// O vetor deve ser bem maior que o último nível de cache, senão a "banda" medida é a da cache.
+
+#define REPETITIONS 5 // Cada medida é a melhor de REPETITIONS execuções
+#define LANES 64      // Elementos processados juntos: cadeias de FMA independentes
+#define PEAK_ITERS 20000000L
+#define MAX_FMAS 1024 // Maior K da varredura
+
+#define FMA_A 0.999999
+#define FMA_B 1e-6
+
+typedef struct {
+  const char *name;
+  double intensity; // FLOP por byte
+  double flops;     // FLOP/s
+  double bytes;     // bytes/s
+} roof_point;
+
+double now_seconds(void){
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec / 1e6;
+}
+
+// Preenchimento paralelo com o mesmo escalonamento dos kernels (primeiro toque)
+void fill_vector(double *v, long n, double value){
+  #pragma omp parallel for schedule(static)
+  for (long i = 0; i < n; i++) v[i] = value + (double)(i % 1000) / 1000.0;
+}
+
+void fill_int_vector(int *v, long n){
+  #pragma omp parallel for schedule(static)
+  for (long i = 0; i < n; i++) v[i] = i < 100 ? i : 100;
+}
+
+// --- Tetos ---
+
+void triad(double *a, const double *b, const double *c, long n){
+  #pragma omp parallel for simd schedule(static)
+  for (long i = 0; i < n; i++) a[i] = b[i] + 3.0 * c[i];
+}
+
+void update(double *v, long n){
+  #pragma omp parallel for simd schedule(static)
+  for (long i = 0; i < n; i++) v[i] = 0.5 * v[i];
+}
+
+// Cada thread mantém LANES acumuladores; a soma final impede que o compilador descarte o laço
+double peak_fma(long iters){
+  double total = 0.0;
+  #pragma omp parallel reduction(+ : total)
+  {
+    double acc[LANES];
+    for (int j = 0; j < LANES; j++) acc[j] = 1.0 + j * 1e-3 + omp_get_thread_num();
+    for (long r = 0; r < iters; r++){
+      #pragma omp simd
+      for (int j = 0; j < LANES; j++) acc[j] = acc[j] * FMA_A + FMA_B;
+    }
+    for (int j = 0; j < LANES; j++) total += acc[j];
+  }
+  return total;
+}
+
+// --- Varredura de intensidade: K FMAs por elemento, um load e um store ---
+
+void intensity_kernel(double *v, long n, int fmas){
+  long blocks = n / LANES;
+  #pragma omp parallel for schedule(static)
+  for (long blk = 0; blk < blocks; blk++){
+    double *x = v + blk * LANES;
+    double r[LANES];
+    #pragma omp simd
+    for (int j = 0; j < LANES; j++) r[j] = x[j];
+    for (int k = 0; k < fmas; k++){
+      #pragma omp simd
+      for (int j = 0; j < LANES; j++) r[j] = r[j] * FMA_A + FMA_B;
+    }
+    #pragma omp simd
+    for (int j = 0; j < LANES; j++) x[j] = r[j];
+  }
+  for (long i = blocks * LANES; i < n; i++){ // Resto que não completa um bloco
+    for (int k = 0; k < fmas; k++) v[i] = v[i] * FMA_A + FMA_B;
+  }
+}
+
+// --- Kernels originais ---
+
+void soma_vetores(long size, int *a, const int *b, const int *c, const int *d){
+  #pragma omp parallel for simd schedule(static)
+  for (long i = 0; i < size; i++) a[i] = b[i] + c[i] + d[i];
+}
+
+double calculos_complexos(const double *x, long n){
+  double sum = 0.0;
+  #pragma omp parallel for simd schedule(static) reduction(+ : sum)
+  for (long i = 0; i < n; i++) sum += element_poly(x[i]);
+  return sum;
+}
+
+// Melhor tempo de REPETITIONS execuções de um trecho de código
+#define BEST_TIME(best, code)                      \
+  do {                                             \
+    best = INFINITY;                               \
+    for (int rep_ = 0; rep_ < REPETITIONS; rep_++){ \
+      double t0_ = now_seconds();                  \
+      code;                                        \
+      double t_ = now_seconds() - t0_;             \
+      if (t_ < best) best = t_;                    \
+    }                                              \
+  } while (0)
+
+roof_point make_point(const char *name, double flop_count, double byte_count, double seconds){
+  roof_point p = {name, flop_count / byte_count, flop_count / seconds, byte_count / seconds};
+  return p;
+}
+
+int main(int argc, char *argv[]){
+  if (argc < 2 || argc > 4){
+    printf("Uso: %s <tamanho do vetor> [número de threads] [arquivo CSV]\n", argv[0]);
+    return 1;
+  }
+
+  long n = atol(argv[1]);
+  if (n < LANES){
+    printf("O vetor deve ter pelo menos %d elementos\n", LANES);
+    return 1;
+  }
+  if (argc > 2) omp_set_num_threads(atoi(argv[2]));
+
+  double *a = malloc(sizeof(double) * n);
+  double *b = malloc(sizeof(double) * n);
+  double *c = malloc(sizeof(double) * n);
+  int *ia = malloc(sizeof(int) * n), *ib = malloc(sizeof(int) * n);
+  int *ic = malloc(sizeof(int) * n), *id = malloc(sizeof(int) * n);
+  if (!a || !b || !c || !ia || !ib || !ic || !id){
+    printf("Memória insuficiente para %ld elementos\n", n);
+    return 1;
+  }
+  fill_vector(a, n, 0.0);
+  fill_vector(b, n, 1.0);
+  fill_vector(c, n, 1.0);
+  fill_int_vector(ia, n);
+  fill_int_vector(ib, n);
+  fill_int_vector(ic, n);
+  fill_int_vector(id, n);
+
+  // --- Tetos ---
+  double t, checksum = 0.0;
+  BEST_TIME(t, triad(a, b, c, n));
+  double triad_bw = 24.0 * n / t;
+  BEST_TIME(t, update(a, n));
+  double update_bw = 16.0 * n / t;
+  double peak_bw = fmax(triad_bw, update_bw);
+
+  BEST_TIME(t, checksum += peak_fma(PEAK_ITERS));
+  double peak_flops = 2.0 * LANES * PEAK_ITERS * omp_get_max_threads() / t;
+  double ridge = peak_flops / peak_bw;
+
+  printf("Threads: %d, vetor: %ld elementos (%.1f MB por vetor de double)\n",
+         omp_get_max_threads(), n, 8.0 * n / 1e6);
+  printf("Banda de pico:         %.2f GB/s (triad %.2f, atualização %.2f)\n",
+         peak_bw / 1e9, triad_bw / 1e9, update_bw / 1e9);
+  printf("FLOP/s de pico (FMA):  %.2f GFLOP/s\n", peak_flops / 1e9);
+  printf("Joelho do roofline:    %.2f FLOP/byte\n\n", ridge);
+
+  // --- Varredura e kernels ---
+  int n_sweep = 0;
+  for (int k = 1; k <= MAX_FMAS; k *= 2) n_sweep++;
+  roof_point *points = malloc(sizeof(roof_point) * (n_sweep + 2));
+  char (*labels)[32] = malloc(sizeof(*labels) * n_sweep);
+
+  int p = 0;
+  for (int k = 1; k <= MAX_FMAS; k *= 2, p++){
+    BEST_TIME(t, intensity_kernel(a, n, k));
+    snprintf(labels[p], sizeof labels[p], "fma_%d", k);
+    points[p] = make_point(labels[p], 2.0 * k * n, 16.0 * n, t);
+  }
+
+  BEST_TIME(t, soma_vetores(n, ia, ib, ic, id));
+  points[p++] = make_point("soma_vetores", 2.0 * n, 16.0 * n, t); // Operações de int
+
+  BEST_TIME(t, checksum += calculos_complexos(b, n));
+  points[p++] = make_point("calculos_complexos", (double)POLY_ELEMENT_FLOPS * n, 8.0 * n, t);
+
+  printf("%-20s %12s %12s %10s %14s %8s  %s\n", "kernel", "FLOP/byte", "GFLOP/s", "GB/s",
+         "teto GFLOP/s", "% teto", "limitado por");
+  for (int i = 0; i < p; i++){
+    double roof = fmin(peak_flops, points[i].intensity * peak_bw);
+    printf("%-20s %12.3f %12.3f %10.2f %14.3f %7.1f%%  %s\n", points[i].name, points[i].intensity,
+           points[i].flops / 1e9, points[i].bytes / 1e9, roof / 1e9, 100.0 * points[i].flops / roof,
+           points[i].intensity < ridge ? "memória" : "processamento");
+  }
+
+  if (argc > 3){
+    FILE *csv = fopen(argv[3], "w");
+    if (csv == NULL){
+      printf("Não foi possível abrir %s\n", argv[3]);
+      return 1;
+    }
+    fprintf(csv, "kernel,intensidade_flop_byte,gflops,gbs,teto_gflops\n");
+    fprintf(csv, "pico_banda,,,%f,\n", peak_bw / 1e9);
+    fprintf(csv, "pico_flops,,%f,,\n", peak_flops / 1e9);
+    for (int i = 0; i < p; i++){
+      fprintf(csv, "%s,%f,%f,%f,%f\n", points[i].name, points[i].intensity, points[i].flops / 1e9,
+              points[i].bytes / 1e9, fmin(peak_flops, points[i].intensity * peak_bw) / 1e9);
+    }
+    fclose(csv);
+    printf("\nRoofline exportado para %s\n", argv[3]);
+  }
+
+  printf("\n(checksum %g)\n", checksum + a[n / 2] + ia[n / 2]);
+
+  free(points);
+  free(labels);
+  free(a); free(b); free(c);
+  free(ia); free(ib); free(ic); free(id);
+  return 0;
+}
@@ -0,0 +1,162 @@
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Contagem de primos por divisão por tentativa com políticas de escalonamento selecionáveis.
+// O custo da iteração i cresce com √i para primos e cai muito para compostos (o laço para no
+// primeiro divisor), então a divisão estática em blocos deixa as threads dos índices baixos paradas.
+// Políticas:
+//   static        blocos contíguos, um por thread (o padrão de cont_numeros_primos_parallel.c)
+//   static_chunk  blocos de <chunk> iterações distribuídos em rodízio
+//   dynamic       cada thread pega o próximo bloco de <chunk> iterações quando termina o seu
+//   guided        como dynamic, com blocos que diminuem até <chunk>
+//   tasks         divisão recursiva do intervalo em tarefas de até <chunk> iterações; threads
+//                 ociosas pegam tarefas pendentes (roubo de trabalho no runtime do OpenMP)
+// Para cada política imprime o tempo ocupado de cada thread e o desbalanceamento, máximo / média:
+// 1.0 é perfeito, e P threads com todo o trabalho numa só dão P.
+// Compilar com: gcc -O3 -fopenmp cont_numeros_primos_schedule.c -o cont_primos_schedule -lm
+// Uso: ./cont_primos_schedule <número máximo> [política|all] [chunk] [número de threads]
+
+#define DEFAULT_CHUNK 1024
+
+int is_prime(long i){
+  if (i < 2) return 0;
+  long limit = (long) floor(sqrt(i)); // Só precisa verificar até a raiz quadrada
+  for (long j = 2; j <= limit; j++){
+    if (i % j == 0) return 0;
+  }
+  return 1;
+}
+
+// Laços com schedule(runtime): a política vem de omp_set_schedule.
+// busy[t] é o tempo que a thread t levou para terminar as suas iterações (nowait: não espera as outras).
+long count_primes_loop(long max_number, omp_sched_t kind, int chunk, double *busy){
+  long count = 0;
+  omp_set_schedule(kind, chunk);
+
+  #pragma omp parallel reduction(+ : count)
+  {
+    double start = omp_get_wtime();
+
+    #pragma omp for schedule(runtime) nowait
+    for (long i = 2; i <= max_number; i++){
+      if (is_prime(i)) count++;
+    }
+
+    busy[omp_get_thread_num()] = omp_get_wtime() - start;
+  }
+
+  return count;
+}
+
+// Divide [low, high) ao meio até ficar com no máximo grain iterações; cada folha soma o tempo gasto
+// no busy da thread que a executou
+void count_range_task(long low, long high, long grain, long *count, double *busy){
+  if (high - low > grain){
+    long mid = low + (high - low) / 2;
+    #pragma omp task shared(count, busy)
+    count_range_task(low, mid, grain, count, busy);
+    #pragma omp task shared(count, busy)
+    count_range_task(mid, high, grain, count, busy);
+    #pragma omp taskwait
+    return;
+  }
+
+  double start = omp_get_wtime();
+  long local = 0;
+  for (long i = low; i < high; i++) local += is_prime(i);
+
+  #pragma omp atomic
+  *count += local;
+  busy[omp_get_thread_num()] += omp_get_wtime() - start;
+}
+
+long count_primes_tasks(long max_number, int chunk, double *busy){
+  long count = 0;
+
+  #pragma omp parallel
+  #pragma omp single
+  count_range_task(2, max_number + 1, chunk, &count, busy);
+
+  return count;
+}
+
+typedef struct {
+  const char *name;
+  omp_sched_t kind; // Não usado por tasks
+  int chunked;      // Usa o chunk da linha de comando
+} policy;
+
+static const policy policies[] = {
+  {"static", omp_sched_static, 0},
+  {"static_chunk", omp_sched_static, 1},
+  {"dynamic", omp_sched_dynamic, 1},
+  {"guided", omp_sched_guided, 1},
+  {"tasks", omp_sched_static, 1},
+};
+#define N_POLICIES (int)(sizeof(policies) / sizeof(policies[0]))
+
+void run_policy(const policy *p, long max_number, int chunk, int nthreads){
+  double *busy = calloc(nthreads, sizeof(double));
+
+  double start = omp_get_wtime();
+  long result = strcmp(p->name, "tasks") == 0
+              ? count_primes_tasks(max_number, chunk, busy)
+              : count_primes_loop(max_number, p->kind, p->chunked ? chunk : 0, busy);
+  double elapsed_time = omp_get_wtime() - start;
+
+  double max_busy = 0.0, sum_busy = 0.0;
+  for (int t = 0; t < nthreads; t++){
+    if (busy[t] > max_busy) max_busy = busy[t];
+    sum_busy += busy[t];
+  }
+  double mean_busy = sum_busy / nthreads;
+
+  printf("%-13s %10ld %12f %14.3f  ", p->name, result, elapsed_time,
+         mean_busy > 0.0 ? max_busy / mean_busy : 1.0);
+  for (int t = 0; t < nthreads; t++) printf(" %.3f", busy[t]);
+  printf("\n");
+
+  free(busy);
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2 || argc > 5)
+  {
+    printf("Uso: %s <número máximo> [política|all] [chunk] [número de threads]\n", argv[0]);
+    printf("Políticas:");
+    for (int p = 0; p < N_POLICIES; p++) printf(" %s", policies[p].name);
+    printf("\n");
+    return 1;
+  }
+
+  long maxNumber = atol(argv[1]);
+  const char *selected = argc > 2 ? argv[2] : "all";
+  int chunk = argc > 3 ? atoi(argv[3]) : DEFAULT_CHUNK;
+  if (argc > 4) omp_set_num_threads(atoi(argv[4]));
+  int nthreads = omp_get_max_threads();
+
+  if (chunk <= 0){
+    printf("O chunk deve ser positivo\n");
+    return 1;
+  }
+
+  int found = strcmp(selected, "all") == 0;
+  for (int p = 0; p < N_POLICIES; p++) found |= strcmp(selected, policies[p].name) == 0;
+  if (!found){
+    printf("Política desconhecida: %s\n", selected);
+    return 1;
+  }
+
+  printf("N = %ld, chunk = %d, %d threads\n", maxNumber, chunk, nthreads);
+  printf("%-14s %10s %12s %14s   %s\n", "política", "primos", "tempo (s)", "desbalanc.", "tempo ocupado por thread (s)"); // "í" ocupa 2 bytes
+
+  for (int p = 0; p < N_POLICIES; p++){
+    if (strcmp(selected, "all") == 0 || strcmp(selected, policies[p].name) == 0)
+      run_policy(&policies[p], maxNumber, chunk, nthreads);
+  }
+  return 0;
+}
@@ -0,0 +1,152 @@
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+#include <math.h>
+
+// Contagem de primos com crivo de Eratóstenes segmentado, no lugar da divisão por tentativa
+// (O(N √N)) de cont_numeros_primos_*.c, em que o count++ paralelo ainda é uma condição de corrida.
+// - Os primos base até √N saem de um crivo simples.
+// - [1, N] é cortado em segmentos que cabem na L1 (SEGMENT_BYTES). Cada segmento guarda só os
+//   ímpares, 1 bit por número (bit ligado = composto), e é crivado com os primos base.
+// - Os segmentos são distribuídos entre as threads; cada thread tem o seu buffer e conta os bits
+//   desligados com popcount. As contagens se juntam com reduction.
+// Para N <= CHECK_LIMIT o resultado é conferido com a divisão por tentativa (paralela, com reduction).
+// Compilar com: gcc -O3 -march=native -fopenmp cont_numeros_primos_sieve.c -o cont_primos_sieve -lm
+// Uso: ./cont_primos_sieve <número máximo> [número de threads]
+
+#ifndef SEGMENT_BYTES
+#define SEGMENT_BYTES (32 * 1024)
+#endif
+
+#define SEGMENT_WORDS (SEGMENT_BYTES / 8)
+#define SEGMENT_ODDS ((long)SEGMENT_BYTES * 8) // Ímpares por segmento
+#define SEGMENT_SPAN (2 * SEGMENT_ODDS)         // Números (pares e ímpares) por segmento
+#define CHECK_LIMIT 10000000L
+
+// Primos ímpares até limit (crivo simples de bytes); devolve quantos foram escritos em *primes
+long base_primes(long limit, uint32_t **primes){
+  char *composite = calloc(limit + 1, 1);
+  uint32_t *list = malloc(sizeof(uint32_t) * (limit / 2 + 1));
+  long count = 0;
+
+  for (long i = 3; i <= limit; i += 2){
+    if (composite[i]) continue;
+    list[count++] = (uint32_t)i;
+    for (long j = i * i; j <= limit; j += 2 * i) composite[j] = 1;
+  }
+
+  free(composite);
+  *primes = list;
+  return count;
+}
+
+// Primos ímpares em [low, low + SEGMENT_SPAN) ∩ [1, max_number], com low ímpar.
+// O bit j do segmento representa o número low + 2j.
+long sieve_segment(long low, long max_number, const uint32_t *primes, long n_primes, uint64_t *bits){
+  memset(bits, 0, SEGMENT_BYTES);
+  long high = low + SEGMENT_SPAN - 1; // Último número representado
+
+  for (long k = 0; k < n_primes; k++){
+    long p = primes[k];
+    long start = p * p;
+    if (start > high) break;
+    if (start < low){
+      start = (low + p - 1) / p * p;  // Primeiro múltiplo de p >= low
+      if ((start & 1) == 0) start += p; // Só múltiplos ímpares
+    }
+    for (long j = (start - low) / 2; j < SEGMENT_ODDS; j += p) bits[j >> 6] |= 1ULL << (j & 63);
+  }
+  if (low == 1) bits[0] |= 1; // 1 não é primo
+
+  // Descarta o que passou de max_number
+  long valid = max_number >= high ? SEGMENT_ODDS : (max_number - low) / 2 + 1;
+  long full_words = valid / 64;
+  long count = 0;
+  for (long w = 0; w < full_words; w++) count += __builtin_popcountll(~bits[w]);
+  if (valid % 64) count += __builtin_popcountll(~bits[full_words] & ((1ULL << (valid % 64)) - 1));
+
+  return count;
+}
+
+long count_number_primes_sieve(long max_number){
+  if (max_number < 2) return 0;
+
+  uint32_t *primes;
+  long n_primes = base_primes((long)sqrtl(max_number) + 1, &primes);
+  long n_segments = (max_number - 1) / SEGMENT_SPAN + 1; // Segmentos começando em 1, 1 + SPAN, ...
+  long count = 1;                                         // O 2
+
+  #pragma omp parallel reduction(+ : count)
+  {
+    uint64_t *bits = malloc(SEGMENT_BYTES);
+
+    #pragma omp for schedule(dynamic)
+    for (long s = 0; s < n_segments; s++){
+      count += sieve_segment(1 + s * SEGMENT_SPAN, max_number, primes, n_primes, bits);
+    }
+
+    free(bits);
+  }
+
+  free(primes);
+  return count;
+}
+
+// Versão original, com reduction no lugar do count++ compartilhado
+long count_number_primes_trial(long max_number){
+  long count = 0;
+
+  #pragma omp parallel for schedule(dynamic, 1024) reduction(+ : count)
+  for (long i = 2; i <= max_number; i++){
+    int is_prime = 1;
+    long limit = (long) floor(sqrt(i)); // Só precisa verificar até a raiz quadrada
+
+    for (long j = 2; j <= limit; j++){
+      if (i % j == 0){
+        is_prime = 0;
+        break;
+      }
+    }
+
+    if (is_prime) count++;
+  }
+
+  return count;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc != 2 && argc != 3)
+  {
+    printf("Uso: %s <número máximo> [número de threads]\n", argv[0]);
+    return 1;
+  }
+
+  long maxNumber = atol(argv[1]);
+  if (argc == 3) omp_set_num_threads(atoi(argv[2]));
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  long result = count_number_primes_sieve(maxNumber);
+  gettimeofday(&end, NULL);
+
+  double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+
+  printf("Quantidade de primos encontrados: %ld\n", result);
+  printf("Tempo de execução (crivo, %d threads): %f segundos\n", omp_get_max_threads(), elapsed_time);
+
+  if (maxNumber <= CHECK_LIMIT){
+    gettimeofday(&start, NULL);
+    long expected = count_number_primes_trial(maxNumber);
+    gettimeofday(&end, NULL);
+    elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+    printf("Divisão por tentativa: %ld primos em %f segundos (%s)\n", expected, elapsed_time,
+           expected == result ? "confere" : "DIFERENTE");
+    if (expected != result) return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,266 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <signal.h>
+#include <unistd.h>
+#include <omp.h>
+#include "mc_rng.h"
+
+// estimativa_pi determinística e retomável, para rodar 10^12 pontos em vários jobs:
+//   run    conta os acertos das amostras [início, início + quantidade) com Philox (a amostra i
+//          usa sempre os mesmos números, com qualquer número de threads ou escalonamento).
+//          O trabalho anda em blocos de CHUNK amostras; depois de cada bloco o prefixo está
+//          completo, então o estado inteiro é {próxima amostra, acertos}. Ele é salvo no arquivo
+//          a cada intervalo, no fim e ao receber SIGINT/SIGTERM. Se o arquivo já existe com a
+//          mesma semente e o mesmo intervalo, a execução continua de onde parou.
+//   merge  lê os arquivos de vários shards, confere semente, término e sobreposição, e soma.
+// O arquivo é texto ("chave valor" por linha), gravado num .tmp e renomeado, para que uma queda
+// no meio da gravação não estrague o checkpoint anterior.
+// Compilar com: gcc -O3 -march=native -fopenmp codigo_paralelo_checkpoint.c -o codigo_paralelo_checkpoint -lm
+// Uso: ./codigo_paralelo_checkpoint run <semente> <início> <quantidade> <arquivo> [threads] [intervalo (s)]
+//      ./codigo_paralelo_checkpoint merge <arquivo> [arquivo ...]
+// Exemplo: 4 shards de 2.5e11 com início 0, 2.5e11, 5e11 e 7.5e11, depois merge dos 4 arquivos.
+
+#define CHECKPOINT_VERSION 1
+#define BATCH_BLOCKS 256          // Blocos Philox por lote, como em codigo_paralelo_rng.c
+#define BATCH_SAMPLES (2 * BATCH_BLOCKS)
+#define CHUNK (1L << 26)          // Amostras entre verificações do relógio e dos sinais
+#define DEFAULT_INTERVAL 60.0     // Segundos entre checkpoints
+
+typedef struct {
+  uint64_t seed;
+  uint64_t start; // Primeira amostra do shard
+  uint64_t count; // Amostras do shard
+  uint64_t next;  // Próxima amostra a processar: [start, next) já está contado
+  uint64_t hits;
+} mc_checkpoint;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void on_signal(int sig){
+  (void)sig;
+  stop_requested = 1;
+}
+
+static inline int point_hit(uint64_t i, uint64_t seed){
+  uint32_t ux, uy;
+  mc_philox_point(i, seed, &ux, &uy);
+  double x = mc_u32_to_double(ux);
+  double y = mc_u32_to_double(uy);
+  return x * x + y * y <= 1.0;
+}
+
+// Acertos das amostras [a, b): lotes vetorizados em paralelo, pontas fora dos lotes uma a uma
+uint64_t count_range(uint64_t a, uint64_t b, uint64_t seed){
+  uint64_t first = (a + BATCH_SAMPLES - 1) / BATCH_SAMPLES; // Primeiro lote inteiro
+  uint64_t last = b / BATCH_SAMPLES;                          // Fim dos lotes inteiros
+  uint64_t hits = 0;
+
+  if (first >= last){
+    for (uint64_t i = a; i < b; i++) hits += point_hit(i, seed);
+    return hits;
+  }
+
+  for (uint64_t i = a; i < first * BATCH_SAMPLES; i++) hits += point_hit(i, seed);
+  for (uint64_t i = last * BATCH_SAMPLES; i < b; i++) hits += point_hit(i, seed);
+
+  #pragma omp parallel for schedule(static) reduction(+ : hits)
+  for (uint64_t batch = first; batch < last; batch++){
+    uint32_t ux[BATCH_SAMPLES], uy[BATCH_SAMPLES];
+    mc_philox_batch(batch * BATCH_BLOCKS, BATCH_BLOCKS, seed, ux, uy);
+
+    long local = 0;
+    #pragma omp simd reduction(+ : local)
+    for (int j = 0; j < BATCH_SAMPLES; j++){
+      double x = mc_u32_to_double(ux[j]);
+      double y = mc_u32_to_double(uy[j]);
+      local += x * x + y * y <= 1.0;
+    }
+    hits += local;
+  }
+
+  return hits;
+}
+
+int checkpoint_save(const char *path, const mc_checkpoint *c){
+  char tmp[4096];
+  snprintf(tmp, sizeof tmp, "%s.tmp", path);
+  FILE *f = fopen(tmp, "w");
+  if (!f) return 0;
+
+  fprintf(f, "mc_checkpoint %d\n", CHECKPOINT_VERSION);
+  fprintf(f, "seed %llu\nstart %llu\ncount %llu\nnext %llu\nhits %llu\n",
+          (unsigned long long)c->seed, (unsigned long long)c->start, (unsigned long long)c->count,
+          (unsigned long long)c->next, (unsigned long long)c->hits);
+
+  int ok = fflush(f) == 0 && fsync(fileno(f)) == 0;
+  ok = fclose(f) == 0 && ok;
+  return ok && rename(tmp, path) == 0;
+}
+
+// Devolve 1 se leu, 0 se o arquivo não existe, -1 se está inválido
+int checkpoint_load(const char *path, mc_checkpoint *c){
+  FILE *f = fopen(path, "r");
+  if (!f) return 0;
+
+  int version = 0;
+  unsigned long long seed, start, count, next, hits;
+  int n = fscanf(f, "mc_checkpoint %d seed %llu start %llu count %llu next %llu hits %llu",
+                 &version, &seed, &start, &count, &next, &hits);
+  fclose(f);
+
+  if (n != 6 || version != CHECKPOINT_VERSION || next < start || next - start > count) return -1;
+  *c = (mc_checkpoint){seed, start, count, next, hits};
+  return 1;
+}
+
+// Aceita inteiros exatos ("1000000000000") ou notação científica ("1e12")
+uint64_t parse_count(const char *s){
+  char *end;
+  uint64_t v = strtoull(s, &end, 10);
+  if (*end == 'e' || *end == 'E' || *end == '.') v = (uint64_t)strtod(s, NULL);
+  return v;
+}
+
+int run(int argc, char *argv[]){
+  if (argc < 6 || argc > 8){
+    printf("Uso: %s run <semente> <início> <quantidade> <arquivo> [threads] [intervalo (s)]\n", argv[0]);
+    return 1;
+  }
+
+  mc_checkpoint c = {parse_count(argv[2]), parse_count(argv[3]), parse_count(argv[4]), 0, 0};
+  const char *path = argv[5];
+  if (argc > 6) omp_set_num_threads(atoi(argv[6]));
+  double interval = argc > 7 ? atof(argv[7]) : DEFAULT_INTERVAL;
+  c.next = c.start;
+
+  mc_checkpoint saved;
+  int loaded = checkpoint_load(path, &saved);
+  if (loaded < 0){
+    printf("Checkpoint inválido: %s\n", path);
+    return 1;
+  }
+  if (loaded){
+    if (saved.seed != c.seed || saved.start != c.start || saved.count != c.count){
+      printf("%s é de outro shard (semente %llu, início %llu, quantidade %llu)\n", path,
+             (unsigned long long)saved.seed, (unsigned long long)saved.start, (unsigned long long)saved.count);
+      return 1;
+    }
+    c = saved;
+    printf("Retomando de %s: %llu de %llu amostras feitas\n", path,
+           (unsigned long long)(c.next - c.start), (unsigned long long)c.count);
+  }
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+
+  uint64_t end = c.start + c.count;
+  uint64_t first_next = c.next;
+  double start_time = omp_get_wtime();
+  double last_save = start_time;
+
+  while (c.next < end && !stop_requested){
+    uint64_t b = end - c.next < (uint64_t)CHUNK ? end : c.next + CHUNK;
+    c.hits += count_range(c.next, b, c.seed);
+    c.next = b;
+
+    double now = omp_get_wtime();
+    if (now - last_save >= interval && c.next < end){
+      if (!checkpoint_save(path, &c)) printf("Falha ao gravar %s\n", path);
+      last_save = now;
+    }
+  }
+
+  if (!checkpoint_save(path, &c)){
+    printf("Falha ao gravar %s\n", path);
+    return 1;
+  }
+
+  double elapsed_time = omp_get_wtime() - start_time;
+  uint64_t done = c.next - c.start;
+  printf("Shard [%llu, %llu), semente %llu, threads %d\n", (unsigned long long)c.start,
+         (unsigned long long)end, (unsigned long long)c.seed, omp_get_max_threads());
+  printf("Feito: %llu de %llu amostras, acertos: %llu\n", (unsigned long long)done,
+         (unsigned long long)c.count, (unsigned long long)c.hits);
+  if (done > 0) printf("Estimativa de PI (shard): %.12f\n", 4.0 * (double)c.hits / done);
+  printf("Tempo de execução: %f segundos (%.3e amostras/s)\n", elapsed_time,
+         elapsed_time > 0 ? (c.next - first_next) / elapsed_time : 0.0);
+
+  if (c.next < end){
+    printf("Interrompido; rode o mesmo comando para continuar\n");
+    return 2;
+  }
+  return 0;
+}
+
+static int compare_start(const void *a, const void *b){
+  const mc_checkpoint *x = a, *y = b;
+  return (x->start > y->start) - (x->start < y->start);
+}
+
+int merge(int argc, char *argv[]){
+  if (argc < 3){
+    printf("Uso: %s merge <arquivo> [arquivo ...]\n", argv[0]);
+    return 1;
+  }
+
+  int n = argc - 2;
+  mc_checkpoint *shards = malloc(n * sizeof *shards);
+  int ok = 1;
+
+  for (int i = 0; i < n; i++){
+    if (checkpoint_load(argv[i + 2], &shards[i]) != 1){
+      printf("Não foi possível ler %s\n", argv[i + 2]);
+      free(shards);
+      return 1;
+    }
+    if (shards[i].seed != shards[0].seed){
+      printf("%s usa a semente %llu, diferente de %llu\n", argv[i + 2],
+             (unsigned long long)shards[i].seed, (unsigned long long)shards[0].seed);
+      ok = 0;
+    }
+    if (shards[i].next != shards[i].start + shards[i].count){
+      printf("%s está incompleto (%llu de %llu amostras)\n", argv[i + 2],
+             (unsigned long long)(shards[i].next - shards[i].start), (unsigned long long)shards[i].count);
+      ok = 0;
+    }
+  }
+
+  qsort(shards, n, sizeof *shards, compare_start);
+  uint64_t samples = 0, hits = 0;
+  int contiguous = 1;
+  for (int i = 0; i < n; i++){
+    if (i > 0 && shards[i].start < shards[i - 1].start + shards[i - 1].count){
+      printf("Shards sobrepostos em %llu\n", (unsigned long long)shards[i].start);
+      ok = 0;
+    }
+    if (i > 0 && shards[i].start > shards[i - 1].start + shards[i - 1].count) contiguous = 0;
+    samples += shards[i].next - shards[i].start;
+    hits += shards[i].hits;
+  }
+
+  uint64_t first = shards[0].start, last = shards[n - 1].start + shards[n - 1].count;
+  free(shards);
+  if (!ok || samples == 0) return 1;
+
+  double p = (double)hits / samples;
+  double pi = 4.0 * p;
+  printf("Shards: %d, amostras: %llu, acertos: %llu\n", n, (unsigned long long)samples, (unsigned long long)hits);
+  printf("Intervalo: [%llu, %llu)%s\n", (unsigned long long)first, (unsigned long long)last,
+         contiguous ? "" : " com lacunas");
+  printf("Estimativa de PI: %.12f\n", pi);
+  printf("Erro: %.3e (desvio padrão esperado: %.3e)\n", fabs(pi - M_PI), 4.0 * sqrt(p * (1.0 - p) / samples));
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc >= 2 && strcmp(argv[1], "run") == 0) return run(argc, argv);
+  if (argc >= 2 && strcmp(argv[1], "merge") == 0) return merge(argc, argv);
+
+  printf("Uso: %s run <semente> <início> <quantidade> <arquivo> [threads] [intervalo (s)]\n", argv[0]);
+  printf("     %s merge <arquivo> [arquivo ...]\n", argv[0]);
+  return 1;
+}
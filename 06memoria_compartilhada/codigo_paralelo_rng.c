@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <math.h>
+#include <sys/time.h>
+#include <omp.h>
+#include "mc_rng.h"
+
+// estimativa_pi com os geradores de mc_rng.h, comparados com rand() e rand_r():
+//   rand          srand(time(NULL)) e rand() compartilhado (trava global da glibc)
+//   rand_r        semente time(NULL) ^ tid por thread
+//   xoshiro       um fluxo xoshiro256** por thread, separados por saltos de 2^128
+//   philox        a amostra i usa o contador i / 2: resultado igual com qualquer número de threads
+//   philox_lote   os mesmos números de philox, gerados em lotes num laço vetorizado
+// philox e philox_lote devem dar exatamente a mesma contagem.
+// Compilar com: gcc -O3 -march=native -fopenmp codigo_paralelo_rng.c -o codigo_paralelo_rng -lm
+// Uso: ./codigo_paralelo_rng <número de pontos> [número de threads] [semente]
+
+#define BATCH_BLOCKS 256 // Blocos Philox por lote: 512 amostras, 4 KB de coordenadas na pilha
+
+long estimativa_rand(long pontos_total, uint64_t seed){
+  long pontos_dentro = 0;
+  srand((unsigned)seed);
+
+  #pragma omp parallel for reduction(+ : pontos_dentro)
+  for (long i = 0; i < pontos_total; i++){
+    double x = (double)rand() / RAND_MAX;
+    double y = (double)rand() / RAND_MAX;
+    if (x * x + y * y <= 1.0) pontos_dentro++;
+  }
+
+  return pontos_dentro;
+}
+
+long estimativa_rand_r(long pontos_total, uint64_t seed){
+  long pontos_dentro = 0;
+
+  #pragma omp parallel reduction(+ : pontos_dentro)
+  {
+    unsigned int s = (unsigned)seed ^ omp_get_thread_num();
+
+    #pragma omp for
+    for (long i = 0; i < pontos_total; i++){
+      double x = (double)rand_r(&s) / RAND_MAX;
+      double y = (double)rand_r(&s) / RAND_MAX;
+      if (x * x + y * y <= 1.0) pontos_dentro++;
+    }
+  }
+
+  return pontos_dentro;
+}
+
+long estimativa_xoshiro(long pontos_total, uint64_t seed){
+  long pontos_dentro = 0;
+
+  #pragma omp parallel reduction(+ : pontos_dentro)
+  {
+    mc_xoshiro g;
+    mc_xoshiro_stream(&g, seed, omp_get_thread_num());
+
+    #pragma omp for
+    for (long i = 0; i < pontos_total; i++){
+      uint64_t r = mc_xoshiro_next(&g); // 32 bits para cada coordenada
+      double x = mc_u32_to_double((uint32_t)r);
+      double y = mc_u32_to_double((uint32_t)(r >> 32));
+      if (x * x + y * y <= 1.0) pontos_dentro++;
+    }
+  }
+
+  return pontos_dentro;
+}
+
+long estimativa_philox(long pontos_total, uint64_t seed){
+  long pontos_dentro = 0;
+
+  #pragma omp parallel for reduction(+ : pontos_dentro)
+  for (long i = 0; i < pontos_total; i++){
+    uint32_t ux, uy;
+    mc_philox_point(i, seed, &ux, &uy);
+    double x = mc_u32_to_double(ux);
+    double y = mc_u32_to_double(uy);
+    if (x * x + y * y <= 1.0) pontos_dentro++;
+  }
+
+  return pontos_dentro;
+}
+
+long estimativa_philox_lote(long pontos_total, uint64_t seed){
+  long pontos_dentro = 0;
+  long batch_samples = 2L * BATCH_BLOCKS;
+  long n_batches = pontos_total / batch_samples;
+
+  #pragma omp parallel for reduction(+ : pontos_dentro)
+  for (long b = 0; b < n_batches; b++){
+    uint32_t ux[2 * BATCH_BLOCKS], uy[2 * BATCH_BLOCKS];
+    mc_philox_batch(b * BATCH_BLOCKS, BATCH_BLOCKS, seed, ux, uy);
+
+    long local = 0;
+    #pragma omp simd reduction(+ : local)
+    for (int j = 0; j < 2 * BATCH_BLOCKS; j++){
+      double x = mc_u32_to_double(ux[j]);
+      double y = mc_u32_to_double(uy[j]);
+      local += x * x + y * y <= 1.0;
+    }
+    pontos_dentro += local;
+  }
+
+  for (long i = n_batches * batch_samples; i < pontos_total; i++){ // Amostras que não fecham um lote
+    uint32_t ux, uy;
+    mc_philox_point(i, seed, &ux, &uy);
+    double x = mc_u32_to_double(ux);
+    double y = mc_u32_to_double(uy);
+    if (x * x + y * y <= 1.0) pontos_dentro++;
+  }
+
+  return pontos_dentro;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2 || argc > 4)
+  {
+    printf("Uso: %s <número de pontos> [número de threads] [semente]\n", argv[0]);
+    return 1;
+  }
+
+  long total = atol(argv[1]);
+  if (total <= 0){
+    printf("O número de pontos deve ser positivo\n");
+    return 1;
+  }
+  if (argc > 2) omp_set_num_threads(atoi(argv[2]));
+  uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t)time(NULL);
+
+  typedef long (*estimator_fn)(long, uint64_t);
+  const char *names[] = {"rand", "rand_r", "xoshiro", "philox", "philox_lote"};
+  estimator_fn estimators[] = {estimativa_rand, estimativa_rand_r, estimativa_xoshiro,
+                               estimativa_philox, estimativa_philox_lote};
+  long hits[5];
+
+  printf("Pontos: %ld, threads: %d, semente: %llu\n", total, omp_get_max_threads(), (unsigned long long)seed);
+  printf("%-12s %18s %14s %12s %16s\n", "gerador", "estimativa de PI", "erro", "tempo (s)", "amostras/s");
+
+  for (int e = 0; e < 5; e++){
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    hits[e] = estimators[e](total, seed);
+    gettimeofday(&end, NULL);
+
+    double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+    double pi = 4.0 * (double)hits[e] / total;
+    printf("%-12s %18.10f %14.3e %12f %16.3e\n", names[e], pi, fabs(pi - M_PI), elapsed_time, total / elapsed_time);
+  }
+
+  printf("Contagem philox = philox_lote: %s (%ld acertos)\n", hits[3] == hits[4] ? "sim" : "NÃO", hits[3]);
+  return hits[3] == hits[4] ? 0 : 1;
+}
@@ -0,0 +1,294 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <sys/time.h>
+#include <omp.h>
+#include <immintrin.h>
+#include "mc_rng.h"
+
+// estimativa_pi vetorizada: 16 (AVX-512) ou 8 (AVX2) pontos por iteração, sem desvios.
+// - O gerador é o xoshiro256+ com um fluxo por elemento do registrador: dois conjuntos de estados
+//   (um para x, outro para y), cada um com 4 registradores de 64 bits por lane. Os fluxos de cada
+//   thread e lane são separados por saltos de 2^128 (mc_xoshiro_stream), como em mc_rng.h.
+//   Sem AVX2, o laço escalar usa o mesmo xoshiro256+ com o fluxo da lane 0 de cada thread.
+// - Cada saída de 64 bits vira duas coordenadas de 32 bits; os 24 bits altos são convertidos
+//   direto para float (exato) e escalados por 2^-24.
+// - O teste x² + y² <= 1 é uma comparação com máscara, e os acertos são somados em inteiros
+//   dentro de um registrador, esvaziado a cada FLUSH_ITERS iterações para não estourar.
+// O resultado é validado estatisticamente contra o caminho escalar (Philox, mc_rng.h): as duas
+// frações de acertos devem diferir menos de Z_LIMIT desvios padrão, e o mesmo contra π/4.
+// A precisão de 24 bits introduz um viés da ordem de 2^-24, bem abaixo do erro estatístico.
+// Compilar com: gcc -O3 -march=native -fopenmp codigo_paralelo_simd.c -o codigo_paralelo_simd -lm
+// Uso: ./codigo_paralelo_simd <número de pontos> [número de threads] [semente]
+
+#define FLUSH_ITERS (1L << 20)
+#define Z_LIMIT 4.0
+
+#if defined(__AVX512F__)
+#define ISA_NAME "AVX-512"
+#define LANES64 8 // Lanes de 64 bits por registrador
+#elif defined(__AVX2__)
+#define ISA_NAME "AVX2"
+#define LANES64 4
+#else
+#define ISA_NAME "escalar"
+#define LANES64 1
+#endif
+
+#define POINTS_PER_ITER (2 * LANES64) // Cada lane de 64 bits dá duas coordenadas de 32 bits
+
+// Estados dos 2 * LANES64 fluxos da thread, organizados por palavra: s[w][lane]
+typedef struct {
+  uint64_t sx[4][LANES64] __attribute__((aligned(64)));
+  uint64_t sy[4][LANES64] __attribute__((aligned(64)));
+} simd_state;
+
+void init_state(simd_state *st, uint64_t seed, int tid){
+  for (int lane = 0; lane < LANES64; lane++){
+    mc_xoshiro gx, gy;
+    mc_xoshiro_stream(&gx, seed, (tid * 2) * LANES64 + lane);
+    mc_xoshiro_stream(&gy, seed, (tid * 2 + 1) * LANES64 + lane);
+    for (int w = 0; w < 4; w++){
+      st->sx[w][lane] = gx.s[w];
+      st->sy[w][lane] = gy.s[w];
+    }
+  }
+}
+
+#if defined(__AVX512F__)
+
+typedef struct { __m512i s0, s1, s2, s3; } vgen;
+
+static inline __m512i vgen_next(vgen *g){
+  __m512i result = _mm512_add_epi64(g->s0, g->s3); // xoshiro256+
+  __m512i t = _mm512_slli_epi64(g->s1, 17);
+  g->s2 = _mm512_xor_si512(g->s2, g->s0);
+  g->s3 = _mm512_xor_si512(g->s3, g->s1);
+  g->s1 = _mm512_xor_si512(g->s1, g->s2);
+  g->s0 = _mm512_xor_si512(g->s0, g->s3);
+  g->s2 = _mm512_xor_si512(g->s2, t);
+  g->s3 = _mm512_rol_epi64(g->s3, 45);
+  return result;
+}
+
+static inline __m512 to_unit(__m512i bits){
+  return _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(bits, 8)), _mm512_set1_ps(0x1p-24f));
+}
+
+// Conta os acertos entre "points" pontos (múltiplo de POINTS_PER_ITER, exceto no último bloco)
+long count_hits(simd_state *st, long points){
+  vgen gx = {_mm512_load_si512(st->sx[0]), _mm512_load_si512(st->sx[1]),
+             _mm512_load_si512(st->sx[2]), _mm512_load_si512(st->sx[3])};
+  vgen gy = {_mm512_load_si512(st->sy[0]), _mm512_load_si512(st->sy[1]),
+             _mm512_load_si512(st->sy[2]), _mm512_load_si512(st->sy[3])};
+  const __m512 one = _mm512_set1_ps(1.0f);
+  const __m512i inc = _mm512_set1_epi32(1);
+  long iters = points / POINTS_PER_ITER, total = 0;
+
+  for (long done = 0; done < iters; done += FLUSH_ITERS){
+    long stop = done + FLUSH_ITERS < iters ? done + FLUSH_ITERS : iters;
+    __m512i acc = _mm512_setzero_si512();
+    for (long it = done; it < stop; it++){
+      __m512 x = to_unit(vgen_next(&gx));
+      __m512 y = to_unit(vgen_next(&gy));
+      __m512 d = _mm512_fmadd_ps(x, x, _mm512_mul_ps(y, y));
+      __mmask16 in = _mm512_cmp_ps_mask(d, one, _CMP_LE_OQ);
+      acc = _mm512_mask_add_epi32(acc, in, acc, inc);
+    }
+    total += _mm512_reduce_add_epi32(acc);
+  }
+
+  int rest = (int)(points % POINTS_PER_ITER); // Último vetor incompleto: só as primeiras lanes
+  if (rest){
+    __m512 x = to_unit(vgen_next(&gx));
+    __m512 y = to_unit(vgen_next(&gy));
+    __m512 d = _mm512_fmadd_ps(x, x, _mm512_mul_ps(y, y));
+    __mmask16 in = _mm512_mask_cmp_ps_mask((__mmask16)((1u << rest) - 1), d, one, _CMP_LE_OQ);
+    total += __builtin_popcount(in);
+  }
+
+  return total;
+}
+
+#elif defined(__AVX2__)
+
+typedef struct { __m256i s0, s1, s2, s3; } vgen;
+
+static inline __m256i vgen_next(vgen *g){
+  __m256i result = _mm256_add_epi64(g->s0, g->s3);
+  __m256i t = _mm256_slli_epi64(g->s1, 17);
+  g->s2 = _mm256_xor_si256(g->s2, g->s0);
+  g->s3 = _mm256_xor_si256(g->s3, g->s1);
+  g->s1 = _mm256_xor_si256(g->s1, g->s2);
+  g->s0 = _mm256_xor_si256(g->s0, g->s3);
+  g->s2 = _mm256_xor_si256(g->s2, t);
+  g->s3 = _mm256_or_si256(_mm256_slli_epi64(g->s3, 45), _mm256_srli_epi64(g->s3, 19));
+  return result;
+}
+
+static inline __m256 to_unit(__m256i bits){
+  return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(bits, 8)), _mm256_set1_ps(0x1p-24f));
+}
+
+static inline __m256 dist2(__m256 x, __m256 y){
+#ifdef __FMA__
+  return _mm256_fmadd_ps(x, x, _mm256_mul_ps(y, y));
+#else
+  return _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+#endif
+}
+
+long count_hits(simd_state *st, long points){
+  vgen gx = {_mm256_load_si256((const __m256i *)st->sx[0]), _mm256_load_si256((const __m256i *)st->sx[1]),
+             _mm256_load_si256((const __m256i *)st->sx[2]), _mm256_load_si256((const __m256i *)st->sx[3])};
+  vgen gy = {_mm256_load_si256((const __m256i *)st->sy[0]), _mm256_load_si256((const __m256i *)st->sy[1]),
+             _mm256_load_si256((const __m256i *)st->sy[2]), _mm256_load_si256((const __m256i *)st->sy[3])};
+  const __m256 one = _mm256_set1_ps(1.0f);
+  long iters = points / POINTS_PER_ITER, total = 0;
+
+  for (long done = 0; done < iters; done += FLUSH_ITERS){
+    long stop = done + FLUSH_ITERS < iters ? done + FLUSH_ITERS : iters;
+    __m256i acc = _mm256_setzero_si256();
+    for (long it = done; it < stop; it++){
+      __m256 x = to_unit(vgen_next(&gx));
+      __m256 y = to_unit(vgen_next(&gy));
+      __m256 in = _mm256_cmp_ps(dist2(x, y), one, _CMP_LE_OQ);
+      acc = _mm256_sub_epi32(acc, _mm256_castps_si256(in)); // Lane verdadeira = -1
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    total += (uint32_t)_mm_cvtsi128_si32(s);
+  }
+
+  int rest = (int)(points % POINTS_PER_ITER);
+  if (rest){
+    __m256 x = to_unit(vgen_next(&gx));
+    __m256 y = to_unit(vgen_next(&gy));
+    int in = _mm256_movemask_ps(_mm256_cmp_ps(dist2(x, y), one, _CMP_LE_OQ));
+    total += __builtin_popcount(in & ((1 << rest) - 1));
+  }
+
+  return total;
+}
+
+#else
+
+// Passo escalar do xoshiro256+ de vgen_next: a transição de estado é a mesma do xoshiro256** de
+// mc_rng.h, só a saída muda (s0 + s3), então a saída é lida antes e o estado avança por mc_xoshiro_next
+static inline uint64_t xoshiro_plus_next(mc_xoshiro *g){
+  uint64_t result = g->s[0] + g->s[3];
+  mc_xoshiro_next(g);
+  return result;
+}
+
+long count_hits(simd_state *st, long points){
+  mc_xoshiro gx, gy;
+  memcpy(gx.s, (uint64_t[4]){st->sx[0][0], st->sx[1][0], st->sx[2][0], st->sx[3][0]}, sizeof gx.s);
+  memcpy(gy.s, (uint64_t[4]){st->sy[0][0], st->sy[1][0], st->sy[2][0], st->sy[3][0]}, sizeof gy.s);
+  long total = 0;
+
+  for (long i = 0; i < points; i += 2){ // Cada par de saídas dá dois pontos
+    uint64_t rx = xoshiro_plus_next(&gx), ry = xoshiro_plus_next(&gy);
+    for (int h = 0; h < 2 && i + h < points; h++){
+      float x = (float)((uint32_t)(rx >> (32 * h)) >> 8) * 0x1p-24f;
+      float y = (float)((uint32_t)(ry >> (32 * h)) >> 8) * 0x1p-24f;
+      total += x * x + y * y <= 1.0f;
+    }
+  }
+
+  return total;
+}
+
+#endif
+
+long estimativa_simd(long pontos_total, uint64_t seed){
+  long pontos_dentro = 0;
+
+  #pragma omp parallel reduction(+ : pontos_dentro)
+  {
+    int tid = omp_get_thread_num(), nthreads = omp_get_num_threads();
+    simd_state st;
+    init_state(&st, seed, tid);
+
+    // Pontos da thread em múltiplos de POINTS_PER_ITER; o resto fica com a última thread
+    long iters = pontos_total / POINTS_PER_ITER;
+    long first = iters * tid / nthreads, last = iters * (tid + 1) / nthreads;
+    long points = (last - first) * POINTS_PER_ITER;
+    if (tid == nthreads - 1) points += pontos_total % POINTS_PER_ITER;
+
+    pontos_dentro += count_hits(&st, points);
+  }
+
+  return pontos_dentro;
+}
+
+// Caminho escalar de referência: uma amostra por vez, com desvio, como nas versões originais
+long estimativa_escalar(long pontos_total, uint64_t seed){
+  long pontos_dentro = 0;
+
+  #pragma omp parallel for reduction(+ : pontos_dentro)
+  for (long i = 0; i < pontos_total; i++){
+    uint32_t ux, uy;
+    mc_philox_point(i, seed, &ux, &uy);
+    double x = mc_u32_to_double(ux);
+    double y = mc_u32_to_double(uy);
+    if (x * x + y * y <= 1.0) pontos_dentro++;
+  }
+
+  return pontos_dentro;
+}
+
+double elapsed_seconds(struct timeval start, struct timeval end){
+  return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2 || argc > 4)
+  {
+    printf("Uso: %s <número de pontos> [número de threads] [semente]\n", argv[0]);
+    return 1;
+  }
+
+  long total = atol(argv[1]);
+  if (total <= 0){
+    printf("O número de pontos deve ser positivo\n");
+    return 1;
+  }
+  if (argc > 2) omp_set_num_threads(atoi(argv[2]));
+  uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t)time(NULL);
+  int nthreads = omp_get_max_threads();
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  long hits_simd = estimativa_simd(total, seed);
+  gettimeofday(&end, NULL);
+  double simd_time = elapsed_seconds(start, end);
+
+  gettimeofday(&start, NULL);
+  long hits_scalar = estimativa_escalar(total, seed);
+  gettimeofday(&end, NULL);
+  double scalar_time = elapsed_seconds(start, end);
+
+  double p_simd = (double)hits_simd / total, p_scalar = (double)hits_scalar / total;
+  double se_one = sqrt(M_PI / 4 * (1 - M_PI / 4) / total); // Desvio padrão de uma fração
+  double z_pair = (p_simd - p_scalar) / (se_one * sqrt(2.0));
+  double z_simd = (p_simd - M_PI / 4) / se_one;
+  double z_scalar = (p_scalar - M_PI / 4) / se_one;
+
+  printf("Pontos: %ld, threads: %d, kernel: %s (%d pontos por iteração)\n", total, nthreads, ISA_NAME, POINTS_PER_ITER);
+  printf("%-8s %16s %12s %10s %12s %18s\n", "caminho", "PI", "erro", "z (π/4)", "tempo (s)", "amostras/s/thread");
+  printf("%-8s %16.10f %12.3e %10.2f %12f %18.3e\n", "simd", 4 * p_simd, fabs(4 * p_simd - M_PI), z_simd,
+         simd_time, total / simd_time / nthreads);
+  printf("%-8s %16.10f %12.3e %10.2f %12f %18.3e\n", "escalar", 4 * p_scalar, fabs(4 * p_scalar - M_PI), z_scalar,
+         scalar_time, total / scalar_time / nthreads);
+  printf("Diferença simd - escalar: z = %.2f; speedup %.1fx\n", z_pair, scalar_time / simd_time);
+
+  int ok = fabs(z_pair) < Z_LIMIT && fabs(z_simd) < Z_LIMIT;
+  printf("Validação estatística (|z| < %.0f): %s\n", Z_LIMIT, ok ? "ok" : "FALHOU");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <omp.h>
+#include "mc_rng.h"
+
+// estimativa_pi com redução de variância, no mesmo laço paralelo de codigo_paralelo_rng.c:
+//   uniforme     amostragem simples (Philox), a referência: erro ~ 1/sqrt(N)
+//   estratificada  o quadrado é dividido em m x m células (m = floor(sqrt(N))), um ponto por célula;
+//                as N - m^2 amostras que sobram são uniformes
+//   antitética   pares (x, y) e (1 - x, 1 - y): o indicador do círculo é decrescente nas duas
+//                coordenadas, então os dois pontos do par têm correlação negativa
+//   sobol        sequência de Sobol em 2D (dimensões 1 e 2) com deslocamento digital aleatório (XOR)
+//   halton       sequência de Halton nas bases 2 e 3 com rotação aleatória (Cranley-Patterson)
+// O ponto i de cada estimador depende só de (i, semente), então o resultado não muda com o número
+// de threads. As sequências quase-aleatórias são randomizadas para continuarem sem viés: cada
+// semente dá uma réplica independente, e o erro é o RMSE de R réplicas (sementes semente + r).
+// A coluna erro^2 x tempo é o custo para uma precisão fixa (menor é melhor). No fim, o tempo
+// para chegar à precisão alvo é extrapolado com a taxa de convergência RMSE ~ N^-taxa, ajustada
+// por mínimos quadrados em log-log sobre todos os N medidos.
+// Compilar com: gcc -O3 -march=native -fopenmp codigo_paralelo_vr.c -o codigo_paralelo_vr -lm
+// Uso: ./codigo_paralelo_vr <N máximo> [threads] [réplicas] [precisão alvo] [semente]
+
+#define N_ESTIMATORS 5
+#define MIN_N 1000L
+
+static inline int in_circle(double x, double y){ return x * x + y * y <= 1.0; }
+
+static inline void philox_uv(uint64_t i, uint64_t seed, double *u, double *v){
+  uint32_t ux, uy;
+  mc_philox_point(i, seed, &ux, &uy);
+  *u = mc_u32_to_double(ux);
+  *v = mc_u32_to_double(uy);
+}
+
+// Dois números de 32 bits por semente, fora da faixa de índices das amostras, para os deslocamentos
+static inline void random_shift(uint64_t seed, uint32_t shift[2]){
+  uint32_t out[4];
+  mc_philox4x32(UINT64_MAX, seed, out);
+  shift[0] = out[0];
+  shift[1] = out[1];
+}
+
+long estimativa_uniforme(long n, uint64_t seed){
+  long hits = 0;
+
+  #pragma omp parallel for reduction(+ : hits)
+  for (long i = 0; i < n; i++){
+    double x, y;
+    philox_uv(i, seed, &x, &y);
+    hits += in_circle(x, y);
+  }
+
+  return hits;
+}
+
+long estimativa_estratificada(long n, uint64_t seed){
+  long m = (long)sqrt((double)n);
+  while ((m + 1) * (m + 1) <= n) m++;
+  while (m * m > n) m--;
+  double h = 1.0 / m;
+  long hits = 0;
+
+  #pragma omp parallel for reduction(+ : hits)
+  for (long i = 0; i < n; i++){
+    double x, y;
+    philox_uv(i, seed, &x, &y);
+    if (i < m * m){
+      x = (i / m + x) * h; // Célula (i / m, i % m)
+      y = (i % m + y) * h;
+    }
+    hits += in_circle(x, y);
+  }
+
+  return hits;
+}
+
+long estimativa_antitetica(long n, uint64_t seed){
+  long pairs = n / 2;
+  long hits = 0;
+
+  #pragma omp parallel for reduction(+ : hits)
+  for (long i = 0; i < pairs; i++){
+    double x, y;
+    philox_uv(i, seed, &x, &y);
+    hits += in_circle(x, y) + in_circle(1.0 - x, 1.0 - y);
+  }
+
+  if (n % 2){ // Amostra sem par
+    double x, y;
+    philox_uv(pairs, seed, &x, &y);
+    hits += in_circle(x, y);
+  }
+
+  return hits;
+}
+
+long estimativa_sobol(long n, uint64_t seed){
+  // Dimensão 1: v_j = 2^(31 - j) (inverte os bits do índice). Dimensão 2: polinômio primitivo
+  // x + 1, com v_j = v_(j-1) ^ (v_(j-1) >> 1) a partir de v_0 = 2^31
+  uint32_t v2[32];
+  v2[0] = 1u << 31;
+  for (int j = 1; j < 32; j++) v2[j] = v2[j - 1] ^ (v2[j - 1] >> 1);
+
+  uint32_t shift[2];
+  random_shift(seed, shift);
+  long hits = 0;
+
+  #pragma omp parallel for reduction(+ : hits)
+  for (long i = 0; i < n; i++){
+    uint32_t k = (uint32_t)i, a = 0, b = 0;
+    for (; k; k &= k - 1){ // Só os bits ligados do índice
+      int j = __builtin_ctz(k);
+      a ^= 1u << (31 - j);
+      b ^= v2[j];
+    }
+    hits += in_circle(mc_u32_to_double(a ^ shift[0]), mc_u32_to_double(b ^ shift[1]));
+  }
+
+  return hits;
+}
+
+static inline double radical_inverse(uint64_t i, int base){
+  double inv = 1.0 / base, f = inv, r = 0.0;
+  while (i){
+    r += (i % base) * f;
+    i /= base;
+    f *= inv;
+  }
+  return r;
+}
+
+long estimativa_halton(long n, uint64_t seed){
+  uint32_t shift[2];
+  random_shift(seed, shift);
+  double sx = mc_u32_to_double(shift[0]), sy = mc_u32_to_double(shift[1]);
+  long hits = 0;
+
+  #pragma omp parallel for reduction(+ : hits)
+  for (long i = 0; i < n; i++){
+    double x = radical_inverse(i + 1, 2) + sx;
+    double y = radical_inverse(i + 1, 3) + sy;
+    hits += in_circle(x - (x >= 1.0), y - (y >= 1.0)); // Soma módulo 1
+  }
+
+  return hits;
+}
+
+// Imprime s alinhado à esquerda em width colunas (printf conta bytes, não caracteres UTF-8)
+static void print_name(const char *s, int width){
+  int chars = 0;
+  for (const char *c = s; *c; c++) chars += (*c & 0xC0) != 0x80;
+  printf("%s%*s", s, width > chars ? width - chars : 0, "");
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2 || argc > 6)
+  {
+    printf("Uso: %s <N máximo> [threads] [réplicas] [precisão alvo] [semente]\n", argv[0]);
+    return 1;
+  }
+
+  long max_n = atol(argv[1]);
+  if (argc > 2) omp_set_num_threads(atoi(argv[2]));
+  int reps = argc > 3 ? atoi(argv[3]) : 8;
+  double target = argc > 4 ? atof(argv[4]) : 1e-6;
+  uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : 42;
+  if (max_n < MIN_N || max_n > UINT32_MAX || reps <= 0 || target <= 0){
+    printf("N deve estar entre %ld e 2^32 - 1; réplicas e precisão devem ser positivas\n", MIN_N);
+    return 1;
+  }
+
+  typedef long (*estimator_fn)(long, uint64_t);
+  const char *names[N_ESTIMATORS] = {"uniforme", "estratificada", "antitética", "sobol", "halton"};
+  estimator_fn estimators[N_ESTIMATORS] = {estimativa_uniforme, estimativa_estratificada, estimativa_antitetica,
+                                           estimativa_sobol, estimativa_halton};
+
+  // Somas do ajuste log RMSE = c - taxa log N, e o último (N, tempo) de cada estimador
+  double fit_x[N_ESTIMATORS] = {0}, fit_y[N_ESTIMATORS] = {0}, fit_xx[N_ESTIMATORS] = {0};
+  double fit_xy[N_ESTIMATORS] = {0}, last_n[N_ESTIMATORS], last_time[N_ESTIMATORS];
+  int fit_points[N_ESTIMATORS] = {0};
+
+  printf("N máximo: %ld, threads: %d, réplicas: %d, semente: %llu\n", max_n, omp_get_max_threads(), reps,
+         (unsigned long long)seed);
+  printf("%-14s %12s %16s %12s %12s %14s %14s\n", "estimador", "N", "PI (média)", "RMSE", "tempo (s)",
+         "amostras/s", "erro^2 x tempo");
+
+  for (int e = 0; e < N_ESTIMATORS; e++){
+    for (long n = MIN_N; ; n = n * 10 > max_n && n < max_n ? max_n : n * 10){
+      double sum = 0.0, sq = 0.0, elapsed_time = 0.0;
+      for (int r = 0; r < reps; r++){
+        double start = omp_get_wtime();
+        long hits = estimators[e](n, seed + r);
+        elapsed_time += omp_get_wtime() - start;
+
+        double pi = 4.0 * (double)hits / n;
+        sum += pi;
+        sq += (pi - M_PI) * (pi - M_PI);
+      }
+      double rmse = sqrt(sq / reps);
+      elapsed_time /= reps;
+
+      print_name(names[e], 14);
+      printf(" %12ld %16.10f %12.3e %12f %14.3e %14.3e\n", n, sum / reps, rmse, elapsed_time,
+             n / elapsed_time, rmse * rmse * elapsed_time);
+
+      if (rmse > 0){
+        double lx = log((double)n), ly = log(rmse);
+        fit_x[e] += lx;
+        fit_y[e] += ly;
+        fit_xx[e] += lx * lx;
+        fit_xy[e] += lx * ly;
+        fit_points[e]++;
+      }
+      last_n[e] = n;
+      last_time[e] = elapsed_time;
+      if (n >= max_n) break;
+    }
+  }
+
+  printf("\nPrecisão alvo: %.1e (RMSE ~ N^-taxa)\n", target);
+  printf("%-14s %8s %16s %16s\n", "estimador", "taxa", "N necessário", "tempo (s)");
+  for (int e = 0; e < N_ESTIMATORS; e++){
+    print_name(names[e], 14);
+    int k = fit_points[e];
+    double den = k * fit_xx[e] - fit_x[e] * fit_x[e];
+    if (k < 2 || den <= 0){ // Sem dois pontos não há taxa
+      printf(" %8s %16s %16s\n", "-", "-", "-");
+      continue;
+    }
+    double rate = -(k * fit_xy[e] - fit_x[e] * fit_y[e]) / den;
+    double c = (fit_y[e] + rate * fit_x[e]) / k;
+    if (rate <= 0){
+      printf(" %8.2f %16s %16s\n", rate, "-", "-");
+      continue;
+    }
+    double n_needed = exp((c - log(target)) / rate);
+    if (n_needed < last_n[e]) n_needed = last_n[e];
+    printf(" %8.2f %16.3e %16.3e\n", rate, n_needed, last_time[e] * n_needed / last_n[e]);
+  }
+
+  return 0;
+}
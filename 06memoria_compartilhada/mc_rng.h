@@ -0,0 +1,141 @@
+#ifndef MC_RNG_H
+#define MC_RNG_H
+
+// Geradores para os estimadores de Monte Carlo (estimativa_pi), no lugar de rand() e rand_r().
+// rand() tem uma trava global na glibc, e sementes como time(NULL) ^ tid dão sequências
+// correlacionadas entre threads. Aqui há dois tipos de gerador:
+//   Philox4x32-10 (baseado em contador): a saída é uma função pura de (contador, chave).
+//     A amostra i usa o contador i / 2, então cada amostra tem sempre os mesmos números,
+//     com qualquer número de threads ou escalonamento. Não há estado para dividir entre threads.
+//   xoshiro256** com salto (jump): a thread t avança t saltos de 2^128 passos a partir da semente,
+//     o que dá fluxos sem sobreposição. É mais rápido, mas o resultado depende do número de threads.
+// mc_philox_batch gera um lote de números num laço "omp simd" (cada elemento é um contador
+// independente), para que o gerador vetorize junto com o laço de estimativa_pi.
+
+#include <stdint.h>
+
+#define MC_PHILOX_M0 0xD2511F53u
+#define MC_PHILOX_M1 0xCD9E8D57u
+#define MC_PHILOX_W0 0x9E3779B9u
+#define MC_PHILOX_W1 0xBB67AE85u
+#define MC_PHILOX_ROUNDS 10
+
+// Converte 32 ou 64 bits aleatórios num double uniforme em [0, 1)
+static inline double mc_u32_to_double(uint32_t u){ return u * 0x1p-32; }
+static inline double mc_u64_to_double(uint64_t u){ return (u >> 11) * 0x1p-53; }
+
+// --- Philox4x32-10 ---
+
+// Contador de 128 bits {counter, 0} e chave de 64 bits; escreve 4 palavras de 32 bits em out
+static inline void mc_philox4x32(uint64_t counter, uint64_t key, uint32_t out[4]){
+  uint32_t c0 = (uint32_t)counter, c1 = (uint32_t)(counter >> 32), c2 = 0, c3 = 0;
+  uint32_t k0 = (uint32_t)key, k1 = (uint32_t)(key >> 32);
+
+  for (int r = 0; r < MC_PHILOX_ROUNDS; r++){
+    uint64_t p0 = (uint64_t)MC_PHILOX_M0 * c0;
+    uint64_t p1 = (uint64_t)MC_PHILOX_M1 * c2;
+    uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    c1 = (uint32_t)p1;
+    c3 = (uint32_t)p0;
+    c0 = n0;
+    c2 = n2;
+    k0 += MC_PHILOX_W0;
+    k1 += MC_PHILOX_W1;
+  }
+
+  out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+// Coordenadas (x, y) da amostra "sample": o bloco sample / 2 dá duas amostras
+static inline void mc_philox_point(uint64_t sample, uint64_t key, uint32_t *x, uint32_t *y){
+  uint32_t out[4];
+  mc_philox4x32(sample >> 1, key, out);
+  *x = out[2 * (sample & 1)];
+  *y = out[2 * (sample & 1) + 1];
+}
+
+// Lote das amostras [2 first_block, 2 (first_block + n_blocks)): o bloco b vai para x[b], y[b]
+// (amostra par) e x[n_blocks + b], y[n_blocks + b] (amostra ímpar). A ordem dentro do lote não
+// importa para contagens, e cada amostra continua com os mesmos números de mc_philox_point.
+static inline void mc_philox_batch(uint64_t first_block, int n_blocks, uint64_t key,
+                                   uint32_t *restrict x, uint32_t *restrict y){
+  uint32_t k0 = (uint32_t)key, k1 = (uint32_t)(key >> 32);
+
+  #pragma omp simd
+  for (int b = 0; b < n_blocks; b++){
+    uint64_t counter = first_block + b;
+    uint32_t c0 = (uint32_t)counter, c1 = (uint32_t)(counter >> 32), c2 = 0, c3 = 0;
+    uint32_t r0 = k0, r1 = k1;
+
+    #pragma GCC unroll 10
+    for (int r = 0; r < MC_PHILOX_ROUNDS; r++){
+      uint64_t p0 = (uint64_t)MC_PHILOX_M0 * c0;
+      uint64_t p1 = (uint64_t)MC_PHILOX_M1 * c2;
+      uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ r0;
+      uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ r1;
+      c1 = (uint32_t)p1;
+      c3 = (uint32_t)p0;
+      c0 = n0;
+      c2 = n2;
+      r0 += MC_PHILOX_W0;
+      r1 += MC_PHILOX_W1;
+    }
+
+    x[b] = c0; y[b] = c1;
+    x[n_blocks + b] = c2; y[n_blocks + b] = c3;
+  }
+}
+
+// --- xoshiro256** ---
+
+typedef struct {
+  uint64_t s[4];
+} mc_xoshiro;
+
+static inline uint64_t mc_rotl(uint64_t x, int k){ return (x << k) | (x >> (64 - k)); }
+
+// splitmix64: espalha uma semente qualquer pelos 256 bits de estado
+static inline uint64_t mc_splitmix64(uint64_t *state){
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+static inline uint64_t mc_xoshiro_next(mc_xoshiro *g){
+  uint64_t *s = g->s;
+  uint64_t result = mc_rotl(s[1] * 5, 7) * 9;
+  uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = mc_rotl(s[3], 45);
+  return result;
+}
+
+// Avança 2^128 passos: equivale a 2^128 chamadas de mc_xoshiro_next
+static inline void mc_xoshiro_jump(mc_xoshiro *g){
+  static const uint64_t JUMP[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                  0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+  uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  for (int i = 0; i < 4; i++){
+    for (int b = 0; b < 64; b++){
+      if (JUMP[i] & (1ull << b)){
+        s0 ^= g->s[0]; s1 ^= g->s[1]; s2 ^= g->s[2]; s3 ^= g->s[3];
+      }
+      mc_xoshiro_next(g);
+    }
+  }
+  g->s[0] = s0; g->s[1] = s1; g->s[2] = s2; g->s[3] = s3;
+}
+
+// Fluxo da thread "stream": semente espalhada por splitmix64 e "stream" saltos
+static inline void mc_xoshiro_stream(mc_xoshiro *g, uint64_t seed, int stream){
+  for (int i = 0; i < 4; i++) g->s[i] = mc_splitmix64(&seed);
+  for (int j = 0; j < stream; j++) mc_xoshiro_jump(g);
+}
+
+#endif
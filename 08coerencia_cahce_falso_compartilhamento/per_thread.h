@@ -0,0 +1,64 @@
+#ifndef PER_THREAD_H
+#define PER_THREAD_H
+
+// Acumuladores por thread sem falso compartilhamento.
+// Num vetor compacto como acertos_por_thread (calloc de num_threads ints), 16 threads dividem
+// a mesma linha de cache de 64 bytes: cada incremento invalida a linha nas outras CPUs.
+// Aqui cada thread tem um "slot" alinhado e do tamanho de uma linha de cache (ou de várias, se
+// o tipo for maior). init zera todos os bytes dos slots, então um slot de thread que não entrou no
+// time (time menor que n) soma zero no merge em vez de lixo; reset dá o valor inicial da thread.
+//
+// DEFINE_PER_THREAD(NOME, TIPO, MERGE) gera:
+//   NOME                       o acumulador (vetor de slots + número de threads)
+//   NOME##_init(&acc, n)       aloca n slots com todos os bytes zerados; devolve 0 se faltar memória
+//   NOME##_reset(&acc, tid, z) a thread tid zera o próprio slot com o valor z (chamar na região paralela)
+//   NOME##_local(&acc, tid)    ponteiro para o slot da thread tid
+//   NOME##_merge(&acc, z)      combina os slots, a partir de z, com MERGE(a, b) -> TIPO
+//   NOME##_free(&acc)          libera os slots
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_LINE 64
+
+#define DEFINE_PER_THREAD(NAME, TYPE, MERGE)                                      \
+  typedef struct {                                                                \
+    _Alignas(CACHE_LINE) TYPE value; /* sizeof vira múltiplo de CACHE_LINE */     \
+  } NAME##_slot;                                                                  \
+                                                                                  \
+  typedef struct {                                                                \
+    NAME##_slot *slots;                                                           \
+    int n;                                                                        \
+  } NAME;                                                                         \
+                                                                                  \
+  static inline int NAME##_init(NAME *acc, int n){                                \
+    acc->slots = aligned_alloc(CACHE_LINE, sizeof(NAME##_slot) * n);              \
+    acc->n = n;                                                                   \
+    if (acc->slots == NULL) return 0;                                             \
+    memset(acc->slots, 0, sizeof(NAME##_slot) * n);                               \
+    return 1;                                                                     \
+  }                                                                               \
+                                                                                  \
+  static inline void NAME##_reset(NAME *acc, int tid, TYPE zero){                 \
+    acc->slots[tid].value = zero;                                                 \
+  }                                                                               \
+                                                                                  \
+  static inline TYPE *NAME##_local(NAME *acc, int tid){                           \
+    return &acc->slots[tid].value;                                                \
+  }                                                                               \
+                                                                                  \
+  static inline TYPE NAME##_merge(const NAME *acc, TYPE zero){                    \
+    TYPE result = zero;                                                           \
+    for (int t = 0; t < acc->n; t++) result = MERGE(result, acc->slots[t].value); \
+    return result;                                                                \
+  }                                                                               \
+                                                                                  \
+  static inline void NAME##_free(NAME *acc){                                      \
+    free(acc->slots);                                                             \
+    acc->slots = NULL;                                                            \
+  }
+
+// MERGE mais comum
+#define PER_THREAD_SUM(a, b) ((a) + (b))
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef PERF_REGION_H
+#define PERF_REGION_H
+
+// Contadores de hardware por thread (perf_event_open do Linux) em volta de uma região paralela,
+// para separar o tráfego de coerência do custo do gerador de números aleatórios.
+// Uso, dentro do "#pragma omp parallel":
+//   perf_region_thread_begin(&r);   ... trabalho ...   perf_region_thread_end(&r);
+// e depois da região: perf_region_report(&r, "nome").
+// Eventos: ciclos, instruções, misses de leitura na L1d e na LLC, e HITM (load que encontrou a
+// linha modificada na cache de outro núcleo: o sintoma do falso compartilhamento). HITM é um
+// evento "raw" que muda com o processador: o padrão é 0x04D2 (MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM,
+// Intel Skylake e posteriores) e só é usado quando o CPUID diz GenuineIntel; em AMD, ARM etc. o
+// mesmo código conta outra coisa, então HITM fica "-". A variável de ambiente PERF_HITM_EVENT (hex)
+// escolhe o evento em qualquer processador.
+// Quando um contador não abre (fora do Linux, em VM sem PMU, ou com perf_event_paranoid alto),
+// ele aparece como "-" e o programa segue normalmente.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <omp.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#define PERF_MAX_THREADS 256
+#define PERF_N_EVENTS 5
+#define PERF_DEFAULT_HITM 0x04D2
+
+enum { PERF_CYCLES, PERF_INSTRUCTIONS, PERF_L1D_MISSES, PERF_LLC_MISSES, PERF_HITM };
+static const char *perf_event_names[PERF_N_EVENTS] = {"ciclos", "instruções", "L1d miss", "LLC miss", "HITM"};
+
+typedef struct {
+  _Alignas(64) int fd[PERF_N_EVENTS];
+  uint64_t value[PERF_N_EVENTS];
+  int ok[PERF_N_EVENTS]; // Contador aberto e lido nesta região
+  int error;              // errno da primeira falha, para o aviso
+} perf_thread;
+
+typedef struct {
+  perf_thread threads[PERF_MAX_THREADS];
+  int nthreads;
+} perf_region;
+
+// 1 se o processador é Intel (onde PERF_DEFAULT_HITM é o evento HITM)
+static inline int perf_cpu_is_intel(void){
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int max_leaf, vendor[3];
+  if (!__get_cpuid(0, &max_leaf, &vendor[0], &vendor[2], &vendor[1])) return 0; // ebx, edx, ecx
+  return memcmp(vendor, "GenuineIntel", 12) == 0;
+#else
+  return 0;
+#endif
+}
+
+#ifdef __linux__
+
+// Preenche attr para o evento; devolve 0 se não há código conhecido para ele neste processador
+static inline int perf_event_attr_for(int event, struct perf_event_attr *attr){
+  memset(attr, 0, sizeof *attr);
+  attr->size = sizeof *attr;
+  attr->disabled = 1;
+  attr->exclude_kernel = 1; // Permitido com perf_event_paranoid <= 2
+  attr->exclude_hv = 1;
+  attr->read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  switch (event){
+    case PERF_CYCLES:
+      attr->type = PERF_TYPE_HARDWARE;
+      attr->config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case PERF_INSTRUCTIONS:
+      attr->type = PERF_TYPE_HARDWARE;
+      attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case PERF_L1D_MISSES:
+      attr->type = PERF_TYPE_HW_CACHE;
+      attr->config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    case PERF_LLC_MISSES:
+      attr->type = PERF_TYPE_HW_CACHE;
+      attr->config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    case PERF_HITM: {
+      const char *env = getenv("PERF_HITM_EVENT");
+      if (env == NULL && !perf_cpu_is_intel()) return 0;
+      attr->type = PERF_TYPE_RAW;
+      attr->config = env ? strtoull(env, NULL, 16) : PERF_DEFAULT_HITM;
+      break;
+    }
+  }
+  return 1;
+}
+
+// Abre e liga os contadores da thread atual (pid 0, qualquer CPU)
+static inline void perf_region_thread_begin(perf_region *r){
+  int tid = omp_get_thread_num();
+  if (tid >= PERF_MAX_THREADS) return;
+  if (tid == 0) r->nthreads = omp_get_num_threads();
+
+  perf_thread *t = &r->threads[tid];
+  t->error = 0;
+  for (int e = 0; e < PERF_N_EVENTS; e++){
+    struct perf_event_attr attr;
+    t->ok[e] = 0;
+    if (!perf_event_attr_for(e, &attr)){ // Sem evento para este processador: "-" sem aviso
+      t->fd[e] = -1;
+      continue;
+    }
+    t->fd[e] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (t->fd[e] < 0 && t->error == 0) t->error = errno;
+  }
+  for (int e = 0; e < PERF_N_EVENTS; e++){
+    if (t->fd[e] < 0) continue;
+    ioctl(t->fd[e], PERF_EVENT_IOC_RESET, 0);
+    ioctl(t->fd[e], PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+// Desliga, lê (corrigindo a multiplexação: valor x tempo ligado / tempo contando) e fecha
+static inline void perf_region_thread_end(perf_region *r){
+  int tid = omp_get_thread_num();
+  if (tid >= PERF_MAX_THREADS) return;
+
+  perf_thread *t = &r->threads[tid];
+  for (int e = 0; e < PERF_N_EVENTS; e++){
+    if (t->fd[e] >= 0) ioctl(t->fd[e], PERF_EVENT_IOC_DISABLE, 0);
+  }
+  for (int e = 0; e < PERF_N_EVENTS; e++){
+    if (t->fd[e] < 0) continue;
+    uint64_t data[3]; // valor, tempo ligado, tempo contando
+    if (read(t->fd[e], data, sizeof data) == sizeof data && data[2] > 0){
+      t->value[e] = (uint64_t)((double)data[0] * data[1] / data[2]);
+      t->ok[e] = 1;
+    }
+    close(t->fd[e]);
+    t->fd[e] = -1;
+  }
+}
+
+#else
+
+static inline void perf_region_thread_begin(perf_region *r){
+  int tid = omp_get_thread_num();
+  if (tid >= PERF_MAX_THREADS) return;
+  if (tid == 0) r->nthreads = omp_get_num_threads();
+  for (int e = 0; e < PERF_N_EVENTS; e++) r->threads[tid].ok[e] = 0;
+  r->threads[tid].error = ENOSYS;
+}
+
+static inline void perf_region_thread_end(perf_region *r){ (void)r; }
+
+#endif
+
+// Soma de um evento em todas as threads; devolve 0 se nenhuma thread conseguiu contar
+static inline int perf_region_total(const perf_region *r, int event, uint64_t *total){
+  int any = 0;
+  *total = 0;
+  int n = r->nthreads < PERF_MAX_THREADS ? r->nthreads : PERF_MAX_THREADS;
+  for (int t = 0; t < n; t++){
+    if (!r->threads[t].ok[event]) continue;
+    *total += r->threads[t].value[event];
+    any = 1;
+  }
+  return any;
+}
+
+static inline void perf_print_value(int ok, uint64_t value){
+  if (ok) printf(" %14llu", (unsigned long long)value);
+  else printf(" %14s", "-");
+}
+
+// Tabela por thread e total, com IPC; avisa uma vez se algum contador não estava disponível
+static inline void perf_region_report(const perf_region *r, const char *name){
+  int n = r->nthreads < PERF_MAX_THREADS ? r->nthreads : PERF_MAX_THREADS;
+  int error = 0;
+
+  printf("\nContadores de hardware: %s\n%7s", name, "thread");
+  for (int e = 0; e < PERF_N_EVENTS; e++) printf(" %14s", perf_event_names[e]);
+  printf(" %6s\n", "IPC");
+
+  for (int t = 0; t < n; t++){
+    const perf_thread *th = &r->threads[t];
+    printf("%7d", t);
+    for (int e = 0; e < PERF_N_EVENTS; e++) perf_print_value(th->ok[e], th->value[e]);
+    if (th->ok[PERF_CYCLES] && th->ok[PERF_INSTRUCTIONS] && th->value[PERF_CYCLES] > 0)
+      printf(" %6.2f\n", (double)th->value[PERF_INSTRUCTIONS] / th->value[PERF_CYCLES]);
+    else
+      printf(" %6s\n", "-");
+    if (th->error && !error) error = th->error;
+  }
+
+  printf("%7s", "total");
+  for (int e = 0; e < PERF_N_EVENTS; e++){
+    uint64_t total;
+    int ok = perf_region_total(r, e, &total);
+    perf_print_value(ok, total);
+  }
+  printf("\n");
+
+  if (error){
+    printf("Alguns contadores indisponíveis (%s). Verifique /proc/sys/kernel/perf_event_paranoid,\n"
+           "se a máquina expõe a PMU e, para HITM, o código do evento em PERF_HITM_EVENT.\n", strerror(error));
+  }
+}
+
+#endif
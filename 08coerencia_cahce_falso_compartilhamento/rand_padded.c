@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <math.h>
+#include <omp.h>
+#include "per_thread.h"
+#include "perf_region.h"
+#include "../06memoria_compartilhada/mc_rng.h"
+
+// estimativa_pi com o contador por thread em três formatos, para medir o falso compartilhamento:
+//   compacto  acertos_por_thread[tid]++ num vetor calloc de ints, como em rand_r_v3.c e rand_v3.c
+//   alinhado  o mesmo incremento, mas num slot de per_thread.h (uma linha de cache por thread);
+//             as amostras ficam num registrador e são guardadas uma vez no fim, para que os dois
+//             façam o mesmo acesso volatile por acerto
+//   local     contador local, guardado no slot uma vez no fim, como em rand_r_v2.c
+// Os incrementos dos dois primeiros passam por um ponteiro volatile: nos originais a chamada de
+// rand_r já obriga o acesso à memória a cada acerto; sem isso o compilador manteria o contador
+// num registrador. O gerador é o xoshiro256** de mc_rng.h (um fluxo por thread), mais barato que
+// rand_r, para que o custo do contador apareça.
+// Os slots guardam {acertos, amostras} e são combinados com tally_merge.
+// Cada região paralela é medida com perf_region.h: misses na L1d e eventos HITM (linha modificada
+// na cache de outro núcleo) mostram o tráfego de coerência ao lado da vazão; "-" se indisponível.
+// Compilar com: gcc -O3 -march=native -fopenmp rand_padded.c -o rand_padded -lm
+// Uso: ./rand_padded <número de pontos> [número máximo de threads] [semente]
+
+typedef struct {
+  long hits;
+  long samples;
+} tally;
+
+static inline tally tally_merge(tally a, tally b){
+  return (tally){a.hits + b.hits, a.samples + b.samples};
+}
+
+DEFINE_PER_THREAD(tally_acc, tally, tally_merge)
+
+static perf_region perf; // Contadores da última estimativa
+
+static inline int in_circle(mc_xoshiro *g){
+  uint64_t r = mc_xoshiro_next(g);
+  double x = mc_u32_to_double((uint32_t)r);
+  double y = mc_u32_to_double((uint32_t)(r >> 32));
+  return x * x + y * y <= 1.0;
+}
+
+long estimativa_compacto(long pontos_total, uint64_t seed){
+  int num_threads = omp_get_max_threads();
+  int *acertos_por_thread = calloc(num_threads, sizeof(int));
+
+  #pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    volatile int *acertos = &acertos_por_thread[tid];
+    mc_xoshiro g;
+    mc_xoshiro_stream(&g, seed, tid);
+    perf_region_thread_begin(&perf);
+
+    #pragma omp for
+    for (long i = 0; i < pontos_total; i++){
+      if (in_circle(&g)) (*acertos)++;
+    }
+    perf_region_thread_end(&perf);
+  }
+
+  long total = 0;
+  for (int t = 0; t < num_threads; t++) total += acertos_por_thread[t];
+  free(acertos_por_thread);
+  return total;
+}
+
+long estimativa_alinhado(long pontos_total, uint64_t seed){
+  tally_acc acc;
+  if (!tally_acc_init(&acc, omp_get_max_threads())) return -1;
+
+  #pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    tally_acc_reset(&acc, tid, (tally){0, 0});
+    volatile tally *mine = tally_acc_local(&acc, tid);
+    long samples = 0;
+    mc_xoshiro g;
+    mc_xoshiro_stream(&g, seed, tid);
+    perf_region_thread_begin(&perf);
+
+    #pragma omp for
+    for (long i = 0; i < pontos_total; i++){
+      if (in_circle(&g)) mine->hits++;
+      samples++;
+    }
+    mine->samples = samples;
+    perf_region_thread_end(&perf);
+  }
+
+  tally total = tally_acc_merge(&acc, (tally){0, 0});
+  tally_acc_free(&acc);
+  return total.samples == pontos_total ? total.hits : -1;
+}
+
+long estimativa_local(long pontos_total, uint64_t seed){
+  tally_acc acc;
+  if (!tally_acc_init(&acc, omp_get_max_threads())) return -1;
+
+  #pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    tally local = {0, 0};
+    mc_xoshiro g;
+    mc_xoshiro_stream(&g, seed, tid);
+    perf_region_thread_begin(&perf);
+
+    #pragma omp for
+    for (long i = 0; i < pontos_total; i++){
+      local.hits += in_circle(&g);
+      local.samples++;
+    }
+
+    *tally_acc_local(&acc, tid) = local;
+    perf_region_thread_end(&perf);
+  }
+
+  tally total = tally_acc_merge(&acc, (tally){0, 0});
+  tally_acc_free(&acc);
+  return total.samples == pontos_total ? total.hits : -1;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2 || argc > 4)
+  {
+    printf("Uso: %s <número de pontos> [número máximo de threads] [semente]\n", argv[0]);
+    return 1;
+  }
+
+  long total = atol(argv[1]);
+  int max_threads = argc > 2 ? atoi(argv[2]) : 64;
+  uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t)time(NULL);
+  if (total <= 0 || max_threads <= 0){
+    printf("Pontos e threads devem ser positivos\n");
+    return 1;
+  }
+
+  typedef long (*estimator_fn)(long, uint64_t);
+  const char *names[] = {"compacto", "alinhado", "local"};
+  estimator_fn estimators[] = {estimativa_compacto, estimativa_alinhado, estimativa_local};
+
+  printf("Pontos: %ld, slot: %zu bytes\n", total, sizeof(tally_acc_slot));
+  printf("%7s %-9s %14s %12s %16s %18s %14s %14s\n", "threads", "contador", "PI", "tempo (s)", "amostras/s",
+         "ganho s/ compacto", "L1d miss", "HITM");
+
+  int ok = 1;
+  for (int t = 1; ; t *= 2){
+    int threads = t < max_threads ? t : max_threads;
+    omp_set_num_threads(threads);
+
+    double base_time = 0.0;
+    for (int e = 0; e < 3; e++){
+      double start = omp_get_wtime();
+      long hits = estimators[e](total, seed);
+      double elapsed_time = omp_get_wtime() - start;
+      if (e == 0) base_time = elapsed_time;
+      if (hits < 0) ok = 0;
+
+      printf("%7d %-9s %14.8f %12f %16.3e %17.2fx", threads, names[e], 4.0 * hits / total,
+             elapsed_time, total / elapsed_time, base_time / elapsed_time);
+      uint64_t count;
+      int ok_count = perf_region_total(&perf, PERF_L1D_MISSES, &count);
+      perf_print_value(ok_count, count);
+      ok_count = perf_region_total(&perf, PERF_HITM, &count);
+      perf_print_value(ok_count, count);
+      printf("\n");
+    }
+
+    if (threads == max_threads) break;
+  }
+  perf_region_report(&perf, "local, último número de threads");
+
+  return ok ? 0 : 1;
+}
@@ -4,6 +4,9 @@
 #include <math.h>
 #include <sys/time.h>
 #include <omp.h>
+#include "perf_region.h"
+
+static perf_region perf; // Contadores de hardware da região paralela de estimativa_pi
 
 double estimativa_pi(int pontos_total)
 {
@@ -11,6 +14,7 @@ double estimativa_pi(int pontos_total)
 
   #pragma omp parallel
   {
+    perf_region_thread_begin(&perf);
     int pontos_dentro_local = 0;
     unsigned int seed = time(NULL) ^ omp_get_thread_num(); // Semente única por thread
 
@@ -28,6 +32,7 @@ double estimativa_pi(int pontos_total)
 
     #pragma omp critical
     pontos_dentro += pontos_dentro_local;
+    perf_region_thread_end(&perf);
   }
 
   return 4.0 * (double)pontos_dentro / pontos_total;
@@ -46,6 +51,7 @@ int main()
 
   printf("Estimativa de PI: %f\n", pi);
   printf("Tempo de execução: %f segundos\n", elapsed_time);
+  perf_region_report(&perf, "estimativa_pi");
 
   return 0;
 }
@@ -4,22 +4,27 @@
 #include <math.h>
 #include <sys/time.h>
 #include <omp.h>
+#include "per_thread.h"
+#include "perf_region.h"
+
+// Um slot alinhado a linha de cache por thread: sem falso compartilhamento entre os contadores
+DEFINE_PER_THREAD(acertos_acc, int, PER_THREAD_SUM)
+
+static perf_region perf; // Contadores de hardware da região paralela de estimativa_pi
 
 double estimativa_pi(int pontos_total)
 {
-  int *acertos_por_thread = NULL;
-  int num_threads;
+  acertos_acc acertos_por_thread;
+  if (!acertos_acc_init(&acertos_por_thread, omp_get_max_threads())){
+    printf("Erro ao alocar os contadores por thread\n");
+    return -1.0;
+  }
 
   #pragma omp parallel
   {
-// Garantir que apenas uma thread aloque o vetor e obtenha o número de threads
-    #pragma omp single
-    {
-      num_threads = omp_get_num_threads();                          // Obter o número correto de threads
-      acertos_por_thread = (int *)calloc(num_threads, sizeof(int)); // Alocar o vetor
-    }
-
+    perf_region_thread_begin(&perf);
     int tid = omp_get_thread_num();
+    acertos_acc_reset(&acertos_por_thread, tid, 0);
     int local_acertos = 0;
     unsigned int seed = time(NULL) ^ tid;
 
@@ -36,17 +41,14 @@ double estimativa_pi(int pontos_total)
     }
 
     // Escrever os acertos na posição exclusiva da thread
-    acertos_por_thread[tid] = local_acertos;
+    *acertos_acc_local(&acertos_por_thread, tid) = local_acertos;
+    perf_region_thread_end(&perf);
   }
 
   // Soma serial após a região paralela
-  int total_acertos = 0;
-  for (int i = 0; i < num_threads; i++)
-  {
-    total_acertos += acertos_por_thread[i];
-  }
+  int total_acertos = acertos_acc_merge(&acertos_por_thread, 0);
 
-  free(acertos_por_thread); // Liberar a memória alocada
+  acertos_acc_free(&acertos_por_thread); // Liberar a memória alocada
 
   return 4.0 * (double)total_acertos / pontos_total;
 }
@@ -58,12 +60,14 @@ int main()
   struct timeval start, end;
   gettimeofday(&start, NULL);
   double pi = estimativa_pi(total);
+  if (pi < 0) return 1;
   gettimeofday(&end, NULL);
 
   double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
 
   printf("Estimativa de PI: %f\n", pi);
   printf("Tempo de execução: %f segundos\n", elapsed_time);
+  perf_region_report(&perf, "estimativa_pi");
 
   return 0;
 }
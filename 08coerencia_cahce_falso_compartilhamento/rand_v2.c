@@ -4,27 +4,32 @@
 #include <math.h>
 #include <sys/time.h>
 #include <omp.h>
+#include "per_thread.h"
+#include "perf_region.h"
+
+// Um slot alinhado a linha de cache por thread: sem falso compartilhamento entre os contadores
+DEFINE_PER_THREAD(acertos_acc, int, PER_THREAD_SUM)
+
+static perf_region perf; // Contadores de hardware da região paralela de estimativa_pi
 
 double estimativa_pi(int pontos_total)
 {
-  int num_threads;
-  int *acertos_por_thread;
+  acertos_acc acertos_por_thread;
+  if (!acertos_acc_init(&acertos_por_thread, omp_get_max_threads())){
+    printf("Erro ao alocar os contadores por thread\n");
+    return -1.0;
+  }
 
   // Inicializa a semente do gerador de números aleatórios
   srand(time(NULL));
 
   #pragma omp parallel
   {
+    perf_region_thread_begin(&perf);
     int tid = omp_get_thread_num();
+    acertos_acc_reset(&acertos_por_thread, tid, 0);
     int local_acertos = 0;
 
-    // Alocar o vetor uma única vez por thread 0
-    #pragma omp single
-    {
-      num_threads = omp_get_num_threads();
-      acertos_por_thread = (int *)calloc(num_threads, sizeof(int));
-    }
-
     #pragma omp for
     for (int i = 0; i < pontos_total; i++)
     {
@@ -38,17 +43,14 @@ double estimativa_pi(int pontos_total)
     }
 
     // Armazena o resultado local no vetor compartilhado
-    acertos_por_thread[tid] = local_acertos;
+    *acertos_acc_local(&acertos_por_thread, tid) = local_acertos;
+    perf_region_thread_end(&perf);
   }
 
   // Região serial: soma os acertos
-  int pontos_dentro = 0;
-  for (int i = 0; i < num_threads; i++)
-  {
-    pontos_dentro += acertos_por_thread[i];
-  }
+  int pontos_dentro = acertos_acc_merge(&acertos_por_thread, 0);
 
-  free(acertos_por_thread);
+  acertos_acc_free(&acertos_por_thread);
   return 4.0 * (double)pontos_dentro / pontos_total;
 }
 
@@ -59,12 +61,14 @@ int main()
   struct timeval start, end;
   gettimeofday(&start, NULL);
   double pi = estimativa_pi(total);
+  if (pi < 0) return 1;
   gettimeofday(&end, NULL);
 
   double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
 
   printf("Estimativa de PI: %f\n", pi);
   printf("Tempo de execução: %f segundos\n", elapsed_time);
+  perf_region_report(&perf, "estimativa_pi");
 
   return 0;
 }
@@ -4,12 +4,16 @@
 #include <math.h>
 #include <sys/time.h>
 #include <omp.h>
+#include "../08coerencia_cahce_falso_compartilhamento/perf_region.h"
+
+static perf_region perf; // Contadores de hardware da região paralela de estimativa_pi
 
 double estimativa_pi(int pontos_total){
   int pontos_dentro = 0;
 
   #pragma omp parallel
   {
+    perf_region_thread_begin(&perf);
     unsigned int seed = time(NULL) ^ omp_get_thread_num(); // Semente única por thread
 
     #pragma omp for
@@ -23,6 +27,7 @@ double estimativa_pi(int pontos_total){
         pontos_dentro+= 1;
       }
     }
+    perf_region_thread_end(&perf);
   }
 
   return 4.0 * (double)pontos_dentro / pontos_total;
@@ -41,6 +46,7 @@ int main()
 
   printf("Estimativa de PI: %f\n", pi);
   printf("Tempo de execução: %f segundos\n", elapsed_time);
+  perf_region_report(&perf, "estimativa_pi");
 
   return 0;
 }
@@ -0,0 +1,237 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <omp.h>
+#include "../06memoria_compartilhada/mc_rng.h"
+#include "../08coerencia_cahce_falso_compartilhamento/per_thread.h"
+#include "../08coerencia_cahce_falso_compartilhamento/perf_region.h"
+
+// Os mecanismos de rand_r_atomic, rand_r_critical, rand_r_compartilhado_* e rand_r_reduction
+// num só programa, mais três contadores alternativos, com o nível de contenção como parâmetro.
+// Cada operação sorteia "trabalho" pontos (Philox: o ponto i é sempre o mesmo, com qualquer número
+// de threads) e soma os acertos ao contador compartilhado com uma das estratégias:
+//   atomic       #pragma omp atomic
+//   critical     #pragma omp critical
+//   reduction    reduction(+ : contador); a soma compartilhada acontece só no fim da região
+//   sharded      SHARDS contadores em linhas de cache separadas (per_thread.h), atômicos por shard
+//   cas_backoff  compare-and-swap com espera exponencial após cada falha (a instrução fetch-add
+//                nunca falha; a espera só faz sentido sobre o CAS)
+//   combining    flat combining: a thread publica o valor no próprio slot; quem pega a trava soma
+//                todos os pedidos pendentes de uma vez, e as outras só esperam o slot esvaziar
+// Quanto menor o trabalho, maior a contenção. A latência é o tempo da atualização do contador,
+// medida em uma a cada LAT_STRIDE operações com clock_gettime (o custo do relógio, algumas dezenas
+// de ns, é o piso da tabela); HITM vem de perf_region.h ("-" se indisponível).
+// Todas as estratégias devem chegar à mesma contagem.
+// Compilar com: gcc -O3 -march=native -fopenmp sync_shootout.c -o sync_shootout -lm
+// Uso: ./sync_shootout <operações> [número máximo de threads] [trabalhos, ex.: 1,16,256] [semente]
+
+#define SHARDS 8
+#define LAT_STRIDE 16
+#define BACKOFF_MAX 1024
+#define FC_EMPTY -1L
+
+enum { ATOMIC, CRITICAL, REDUCTION, SHARDED, CAS_BACKOFF, COMBINING, N_STRATEGIES };
+static const char *strategy_names[N_STRATEGIES] = {"atomic", "critical", "reduction", "sharded",
+                                                   "cas_backoff", "combining"};
+
+DEFINE_PER_THREAD(padded_long, long, PER_THREAD_SUM)
+
+static perf_region perf; // Contadores da última estratégia
+
+static inline void cpu_relax(void){
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+
+static inline uint64_t now_ns(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Acertos dos pontos [op * work, (op + 1) * work)
+static inline long op_hits(long op, long work, uint64_t seed){
+  long hits = 0;
+  for (long s = op * work; s < (op + 1) * work; s++){
+    uint32_t ux, uy;
+    mc_philox_point(s, seed, &ux, &uy);
+    double x = mc_u32_to_double(ux);
+    double y = mc_u32_to_double(uy);
+    hits += x * x + y * y <= 1.0;
+  }
+  return hits;
+}
+
+static inline void cas_add(long *counter, long v){
+  long old = __atomic_load_n(counter, __ATOMIC_RELAXED);
+  int delay = 1;
+  while (!__atomic_compare_exchange_n(counter, &old, old + v, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+    for (int k = 0; k < delay; k++) cpu_relax();
+    if (delay < BACKOFF_MAX) delay *= 2;
+  }
+}
+
+// Publica v no slot da thread e espera até algum combinador (talvez ela mesma) consumi-lo.
+// Só o dono da trava escreve no contador.
+static inline void combining_add(padded_long *requests, int *lock, long *counter, int tid, long v){
+  long *mine = padded_long_local(requests, tid);
+  __atomic_store_n(mine, v, __ATOMIC_RELEASE);
+
+  while (__atomic_load_n(mine, __ATOMIC_ACQUIRE) != FC_EMPTY){
+    if (__atomic_load_n(lock, __ATOMIC_RELAXED) == 0 && !__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE)){
+      long sum = 0;
+      for (int t = 0; t < requests->n; t++){
+        long *slot = padded_long_local(requests, t);
+        long r = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+        if (r == FC_EMPTY) continue;
+        sum += r;
+        __atomic_store_n(slot, FC_EMPTY, __ATOMIC_RELEASE);
+      }
+      *counter += sum;
+      __atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+    } else {
+      cpu_relax();
+    }
+  }
+}
+
+// Executa ops operações com a estratégia dada; guarda as latências amostradas em lat e o tamanho
+// real do time em team, e devolve a contagem de acertos
+long run_strategy(int strategy, long ops, long work, uint64_t seed, uint64_t *lat, int *team){
+  long counter = 0, reduced = 0;
+  int lock = 0;
+  padded_long shards, requests;
+  if (!padded_long_init(&shards, SHARDS) || !padded_long_init(&requests, omp_get_max_threads())) return -1;
+  for (int s = 0; s < SHARDS; s++) padded_long_reset(&shards, s, 0);
+  // Todos os slots começam vazios, inclusive os de threads que o runtime não criar
+  for (int t = 0; t < requests.n; t++) padded_long_reset(&requests, t, FC_EMPTY);
+
+  #pragma omp parallel reduction(+ : reduced)
+  {
+    int tid = omp_get_thread_num();
+    #pragma omp single
+    *team = omp_get_num_threads();
+    perf_region_thread_begin(&perf);
+
+    #pragma omp for schedule(static)
+    for (long i = 0; i < ops; i++){
+      long v = op_hits(i, work, seed);
+      int sample = i % LAT_STRIDE == 0;
+      uint64_t t0 = sample ? now_ns() : 0;
+
+      switch (strategy){
+        case ATOMIC:
+          #pragma omp atomic
+          counter += v;
+          break;
+        case CRITICAL:
+          #pragma omp critical
+          counter += v;
+          break;
+        case REDUCTION:
+          reduced += v;
+          break;
+        case SHARDED:
+          __atomic_fetch_add(padded_long_local(&shards, tid % SHARDS), v, __ATOMIC_RELAXED);
+          break;
+        case CAS_BACKOFF:
+          cas_add(&counter, v);
+          break;
+        case COMBINING:
+          combining_add(&requests, &lock, &counter, tid, v);
+          break;
+      }
+
+      if (sample) lat[i / LAT_STRIDE] = now_ns() - t0;
+    }
+    perf_region_thread_end(&perf);
+  }
+
+  long total = counter + reduced + padded_long_merge(&shards, 0);
+  padded_long_free(&shards);
+  padded_long_free(&requests);
+  return total;
+}
+
+static int compare_u64(const void *a, const void *b){
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Percentil p (0..1) de um vetor ordenado
+static uint64_t percentile(const uint64_t *sorted, long n, double p){
+  long k = (long)(p * (n - 1) + 0.5);
+  return sorted[k];
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2 || argc > 5)
+  {
+    printf("Uso: %s <operações> [número máximo de threads] [trabalhos, ex.: 1,16,256] [semente]\n", argv[0]);
+    return 1;
+  }
+
+  long ops = atol(argv[1]);
+  int max_threads = argc > 2 ? atoi(argv[2]) : omp_get_max_threads();
+  char works_arg[256] = "1,16,256";
+  if (argc > 3) snprintf(works_arg, sizeof works_arg, "%s", argv[3]);
+  uint64_t seed = argc > 4 ? strtoull(argv[4], NULL, 10) : 42;
+  if (ops <= 0 || max_threads <= 0){
+    printf("Operações e threads devem ser positivos\n");
+    return 1;
+  }
+
+  long n_lat = (ops + LAT_STRIDE - 1) / LAT_STRIDE;
+  uint64_t *lat = malloc(n_lat * sizeof *lat);
+  if (!lat){
+    printf("Falha ao alocar %ld amostras de latência\n", n_lat);
+    return 1;
+  }
+
+  int ok = 1;
+  for (char *tok = strtok(works_arg, ","); tok; tok = strtok(NULL, ",")){
+    long work = atol(tok);
+    if (work <= 0) continue;
+
+    printf("\nOperações: %ld, trabalho: %ld pontos por operação, semente: %llu\n", ops, work,
+           (unsigned long long)seed);
+    printf("%7s %-12s %14s %10s %10s %12s %14s %4s\n", "threads", "estratégia", "ops/s", "p50 (ns)",
+           "p99 (ns)", "p99.9 (ns)", "HITM", "ok");
+
+    long reference = -1;
+    for (int t = 1; ; t *= 2){
+      int threads = t < max_threads ? t : max_threads;
+      omp_set_num_threads(threads);
+
+      for (int s = 0; s < N_STRATEGIES; s++){
+        double start = omp_get_wtime();
+        int team = 0;
+        long hits = run_strategy(s, ops, work, seed, lat, &team);
+        double elapsed_time = omp_get_wtime() - start;
+        if (reference < 0) reference = hits;
+        int same = hits >= 0 && hits == reference;
+        if (!same) ok = 0;
+
+        qsort(lat, n_lat, sizeof *lat, compare_u64);
+        uint64_t hitm;
+        int hitm_ok = perf_region_total(&perf, PERF_HITM, &hitm);
+
+        printf("%7d %-11s %14.3e %10llu %10llu %12llu", team, strategy_names[s], ops / elapsed_time,
+               (unsigned long long)percentile(lat, n_lat, 0.5), (unsigned long long)percentile(lat, n_lat, 0.99),
+               (unsigned long long)percentile(lat, n_lat, 0.999));
+        perf_print_value(hitm_ok, hitm);
+        printf(" %4s\n", same ? "sim" : "NÃO");
+      }
+
+      if (threads == max_threads) break;
+    }
+    printf("PI com %ld pontos: %.10f\n", ops * work, 4.0 * reference / (ops * work));
+  }
+
+  free(lat);
+  return ok ? 0 : 1;
+}
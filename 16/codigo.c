@@ -26,6 +26,7 @@ int main(int argc, char *argv[]){
     if (rank == 0)
       fprintf(stderr, "M (%d) deve ser divisível por número de processos (%d)\n", M, size);
     MPI_Finalize();
+    return 1;
   }
 
   int local_rows = M / size;
@@ -0,0 +1,148 @@
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+
+// Versão em lote da distribuição por linhas: Y = A * X, onde X reúne K vetores.
+// A é distribuída e lida uma única vez para os K vetores, em vez de uma vez por vetor.
+// X tem N x K elementos (linha j = elemento j dos K vetores) e Y tem M x K.
+// Mede K = 1, 2, 4, ... até o K dado, e o processo 0 confere cada Y contra o produto sequencial.
+// Uso: mpirun -np <p> ./codigo_batch [M] [N] [K máximo]
+
+void fill_matrix(double *A, int rows, int cols){
+  for (size_t i = 0; i < (size_t)rows * cols; i++)
+    A[i] = rand() % 10;
+}
+
+void fill_vector(double *x, size_t size){
+  for (size_t i = 0; i < size; i++)
+    x[i] = rand() % 10;
+}
+
+// local_Y[i][0..K) = soma_j local_A[i][j] * X[j][0..K)
+void multiply_batched(const double *local_A, const double *X, double *local_Y,
+                      int local_rows, int N, int K){
+  for (int i = 0; i < local_rows; i++){
+    double *y = local_Y + (size_t)i * K;
+    for (int k = 0; k < K; k++)
+      y[k] = 0.0;
+    for (int j = 0; j < N; j++){
+      double a = local_A[(size_t)i * N + j];
+      const double *x = X + (size_t)j * K;
+      #pragma omp simd
+      for (int k = 0; k < K; k++)
+        y[k] += a * x[k];
+    }
+  }
+}
+
+// Conferência no processo 0: Y contra o produto sequencial, um vetor por vez
+int count_errors(const double *A, const double *X, const double *Y, int M, int N, int K){
+  int errors = 0;
+  for (int k = 0; k < K; k++){
+    for (int i = 0; i < M; i++){
+      double sum = 0.0;
+      for (int j = 0; j < N; j++)
+        sum += A[(size_t)i * N + j] * X[(size_t)j * K + k];
+      if (Y[(size_t)i * K + k] != sum) errors++; // Inteiros pequenos: soma exata em qualquer ordem
+    }
+  }
+  return errors;
+}
+
+int main(int argc, char *argv[]){
+  int rank, size;
+  int M = argc > 1 ? atoi(argv[1]) : 8; // número total de linhas da matriz
+  int N = argc > 2 ? atoi(argv[2]) : 4; // número de colunas da matriz = tamanho de cada vetor
+  int max_K = argc > 3 ? atoi(argv[3]) : 8; // maior lote; mede K = 1, 2, 4, ... até ele
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (M <= 0 || N <= 0 || max_K <= 0 || M % size != 0){
+    if (rank == 0)
+      fprintf(stderr, "M (%d) deve ser divisível por número de processos (%d), e M, N, K positivos\n", M, size);
+    MPI_Finalize();
+    return 1;
+  }
+
+  int local_rows = M / size;
+
+  // As contagens das chamadas MPI são int
+  if ((size_t)local_rows * N > INT_MAX || (size_t)N * max_K > INT_MAX || (size_t)local_rows * max_K > INT_MAX){
+    if (rank == 0)
+      fprintf(stderr, "Blocos grandes demais para as contagens int do MPI\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  double *A = NULL; // Matriz (só no processo 0)
+  double *X = malloc((size_t)N * max_K * sizeof(double)); // Bloco de K vetores (em todos os processos)
+  double *local_A = malloc((size_t)local_rows * N * sizeof(double));
+  double *local_Y = malloc((size_t)local_rows * max_K * sizeof(double));
+  double *Y = NULL; // Resultado completo M x K (só no processo 0)
+
+  if (rank == 0){
+    A = malloc((size_t)M * N * sizeof(double));
+    Y = malloc((size_t)M * max_K * sizeof(double));
+    srand(time(NULL));
+    fill_matrix(A, M, N);
+  }
+
+  int ok = 1;
+  if (rank == 0){
+    printf("Processos: %d, Matriz %dX%d\n", size, M, N);
+    printf("%4s %14s %14s %12s %12s %s\n", "K", "total (s)", "s por vetor", "cálculo (s)", "GFLOP/s", "conferência");
+  }
+
+  for (int K = 1; ; K = 2 * K < max_K ? 2 * K : max_K){
+    if (rank == 0)
+      fill_vector(X, (size_t)N * K);
+
+    // Medição de tempo começa aqui
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start_time = MPI_Wtime();
+
+    MPI_Bcast(X, N * K, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+    MPI_Scatter(A, local_rows * N, MPI_DOUBLE,
+                local_A, local_rows * N, MPI_DOUBLE,
+                0, MPI_COMM_WORLD);
+
+    double compute_start = MPI_Wtime();
+    multiply_batched(local_A, X, local_Y, local_rows, N, K);
+    double compute_time = MPI_Wtime() - compute_start;
+
+    MPI_Gather(local_Y, local_rows * K, MPI_DOUBLE,
+               Y, local_rows * K, MPI_DOUBLE,
+               0, MPI_COMM_WORLD);
+
+    double end_time = MPI_Wtime();
+    double elapsed = end_time - start_time;
+
+    double max_compute;
+    MPI_Reduce(&compute_time, &max_compute, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0){
+      int errors = count_errors(A, X, Y, M, N, K);
+      if (errors) ok = 0;
+      printf("%4d %14f %14f %12f %12.2f %s\n", K, elapsed, elapsed / K, max_compute,
+             2.0 * M * N * K / max_compute / 1e9, errors == 0 ? "ok" : "ERRO");
+    }
+
+    if (K == max_K) break;
+  }
+
+  free(local_A);
+  free(local_Y);
+  free(X);
+  if (rank == 0){
+    free(A);
+    free(Y);
+  }
+
+  MPI_Finalize();
+  return ok ? 0 : 1;
+}
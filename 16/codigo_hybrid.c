@@ -0,0 +1,160 @@
+#include <mpi.h>
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+
+// Versão híbrida MPI + OpenMP da distribuição por linhas.
+// Um processo por socket e as threads OpenMP dividem as linhas locais, em vez de um processo
+// por núcleo: menos processos participando de cada coletiva. Só a thread principal chama o MPI
+// (MPI_THREAD_FUNNELED).
+// Compilar com: mpicc -O3 -march=native -fopenmp codigo_hybrid.c -o codigo_hybrid
+// Comparação no mesmo número de nós (ex.: 2 sockets x 16 núcleos):
+//   MPI puro: OMP_NUM_THREADS=1  mpirun -np 32 --bind-to core ./codigo_hybrid M N
+//   Híbrido:  OMP_NUM_THREADS=16 mpirun -np 2 --map-by socket --bind-to socket ./codigo_hybrid M N
+// O processo 0 confere y contra o produto sequencial; a última linha impressa tem formato CSV
+// para montar a tabela de escalabilidade.
+
+void fill_matrix(double *A, int rows, int cols){
+  for (size_t i = 0; i < (size_t)rows * cols; i++)
+    A[i] = rand() % 10;
+}
+
+void fill_vector(double *x, int size){
+  for (int i = 0; i < size; i++)
+    x[i] = rand() % 10;
+}
+
+// Tamanho e início do bloco idx quando n elementos são divididos em p blocos
+int block_size(int n, int p, int idx){
+  return n / p + (idx < n % p ? 1 : 0);
+}
+
+int block_start(int n, int p, int idx){
+  return idx * (n / p) + (idx < n % p ? idx : n % p);
+}
+
+int main(int argc, char *argv[]){
+  int rank, size, provided;
+  int M = argc > 1 ? atoi(argv[1]) : 8; // número total de linhas da matriz
+  int N = argc > 2 ? atoi(argv[2]) : 4; // número de colunas da matriz = tamanho do vetor x
+
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (provided < MPI_THREAD_FUNNELED || M <= 0 || N <= 0){
+    if (rank == 0)
+      fprintf(stderr, "É preciso MPI_THREAD_FUNNELED (obtido: %d) e M, N positivos\n", provided);
+    MPI_Finalize();
+    return 1;
+  }
+
+  // As contagens e deslocamentos das chamadas MPI são int; o maior deslocamento + contagem é M * N
+  if ((size_t)M * N > INT_MAX){
+    if (rank == 0)
+      fprintf(stderr, "Matriz grande demais para as contagens int do MPI\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  int *row_counts = malloc(size * sizeof(int));
+  int *row_displs = malloc(size * sizeof(int));
+  int *elem_counts = malloc(size * sizeof(int));
+  int *elem_displs = malloc(size * sizeof(int));
+  for (int p = 0; p < size; p++){
+    row_counts[p] = block_size(M, size, p);
+    row_displs[p] = block_start(M, size, p);
+    elem_counts[p] = row_counts[p] * N;
+    elem_displs[p] = row_displs[p] * N;
+  }
+  int local_rows = row_counts[rank];
+  int threads = omp_get_max_threads();
+
+  double *A = NULL;
+  double *x = malloc(N * sizeof(double));
+  double *local_A = malloc(((size_t)local_rows * N + 1) * sizeof(double));
+  double *local_y = malloc((local_rows + 1) * sizeof(double));
+  double *y = NULL;
+
+  // Primeiro toque do bloco local pelas mesmas threads que vão calculá-lo (páginas no socket certo)
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < local_rows; i++){
+    for (int j = 0; j < N; j++)
+      local_A[(size_t)i * N + j] = 0.0;
+  }
+
+  if (rank == 0){
+    A = malloc((size_t)M * N * sizeof(double));
+    y = malloc(M * sizeof(double));
+    srand(time(NULL));
+    fill_matrix(A, M, N);
+    fill_vector(x, N);
+  }
+
+  // Medição de tempo começa aqui
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start_time = MPI_Wtime();
+
+  MPI_Bcast(x, N, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  MPI_Scatterv(A, elem_counts, elem_displs, MPI_DOUBLE,
+               local_A, local_rows * N, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  double compute_start = MPI_Wtime();
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < local_rows; i++){
+    const double *row = local_A + (size_t)i * N;
+    double sum = 0.0;
+    #pragma omp simd reduction(+ : sum)
+    for (int j = 0; j < N; j++){
+      sum += row[j] * x[j];
+    }
+    local_y[i] = sum;
+  }
+  double compute_time = MPI_Wtime() - compute_start;
+
+  MPI_Gatherv(local_y, local_rows, MPI_DOUBLE,
+              y, row_counts, row_displs, MPI_DOUBLE,
+              0, MPI_COMM_WORLD);
+
+  double end_time = MPI_Wtime();
+  double elapsed = end_time - start_time;
+
+  double max_compute;
+  MPI_Reduce(&compute_time, &max_compute, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+  int errors = 0;
+  if (rank == 0){
+    // Conferência com o produto sequencial (inteiros pequenos: soma exata em qualquer ordem)
+    for (int i = 0; i < M; i++){
+      double sum = 0.0;
+      for (int j = 0; j < N; j++)
+        sum += A[(size_t)i * N + j] * x[j];
+      if (sum != y[i])
+        errors++;
+    }
+
+    printf("Tempo total de execução com %d processos x %d threads e Matriz %dX%d: %f segundos (cálculo %f, comunicação %f)\n",
+           size, threads, M, N, elapsed, max_compute, elapsed - max_compute);
+    printf("Linhas divergentes: %d\n", errors);
+    printf("csv,linhas,%s,%d,%d,%d,%d,%f,%f\n", threads > 1 ? "hibrido" : "mpi",
+           size, threads, M, N, elapsed, max_compute);
+  }
+
+  free(row_counts);
+  free(row_displs);
+  free(elem_counts);
+  free(elem_displs);
+  free(local_A);
+  free(local_y);
+  free(x);
+  if (rank == 0){
+    free(A);
+    free(y);
+  }
+
+  MPI_Finalize();
+  return errors != 0;
+}
@@ -0,0 +1,261 @@
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+#include <math.h>
+
+// Distribuição por linhas com comunicação e cálculo sobrepostos (pipeline).
+// O bloco de linhas de cada processo é dividido em pedaços: enquanto o pedaço k é multiplicado,
+// o MPI_Iscatterv do pedaço k+1 já está em andamento, e cada pedaço de y volta com MPI_Igatherv
+// sem esperar os demais. O programa roda também a versão bloqueante de codigo.c (com Scatterv,
+// para aceitar M não divisível) e mostra, para cada versão, quanto do tempo foi comunicação exposta.
+// A sobreposição de cada processo é a comunicação que o pipeline escondeu: comunicação da versão
+// bloqueante menos a espera que sobrou no pipeline (negativa quando o pipeline esperou mais,
+// comum em matrizes pequenas, em que os pedaços só acrescentam latência).
+// Os buffers de recepção são preenchidos com NaN antes de cada versão, e as duas são conferidas
+// contra y calculado sequencialmente no processo 0: se uma transferência não acontecer, aparece.
+// Uso: mpirun -np <p> ./codigo_pipeline [M] [N] [pedaços]
+
+void fill_matrix(double *A, int rows, int cols){
+  for (size_t i = 0; i < (size_t)rows * cols; i++)
+    A[i] = rand() % 10;
+}
+
+void fill_vector(double *x, int size){
+  for (int i = 0; i < size; i++)
+    x[i] = rand() % 10;
+}
+
+// Tamanho e início do bloco idx quando n elementos são divididos em p blocos
+int block_size(int n, int p, int idx){
+  return n / p + (idx < n % p ? 1 : 0);
+}
+
+int block_start(int n, int p, int idx){
+  return idx * (n / p) + (idx < n % p ? idx : n % p);
+}
+
+// Preenche um buffer de recepção com NaN, para que dados não recebidos não passem na conferência
+void poison(double *v, size_t n){
+  for (size_t i = 0; i < n; i++)
+    v[i] = NAN;
+}
+
+void multiply_rows(const double *local_A, const double *x, double *local_y, int rows, int N){
+  for (int i = 0; i < rows; i++){
+    double sum = 0.0;
+    for (int j = 0; j < N; j++){
+      sum += local_A[(size_t)i * N + j] * x[j];
+    }
+    local_y[i] = sum;
+  }
+}
+
+int main(int argc, char *argv[]){
+  int rank, size;
+  int M = argc > 1 ? atoi(argv[1]) : 8; // número total de linhas da matriz
+  int N = argc > 2 ? atoi(argv[2]) : 4; // número de colunas da matriz = tamanho do vetor x
+  int C = argc > 3 ? atoi(argv[3]) : 4; // número de pedaços do pipeline
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (M <= 0 || N <= 0 || C <= 0){
+    if (rank == 0)
+      fprintf(stderr, "M (%d), N (%d) e o número de pedaços (%d) devem ser positivos\n", M, N, C);
+    MPI_Finalize();
+    return 1;
+  }
+
+  // As contagens e deslocamentos das chamadas MPI são int; o maior deslocamento + contagem é M * N
+  if ((size_t)M * N > INT_MAX){
+    if (rank == 0)
+      fprintf(stderr, "Matriz grande demais para as contagens int do MPI\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  int local_rows = block_size(M, size, rank);
+
+  // Contagens de cada pedaço para cada processo; precisam existir até o fim das operações não bloqueantes
+  int *row_counts = malloc(size * sizeof(int));
+  int *row_displs = malloc(size * sizeof(int));
+  int *elem_counts = malloc(size * sizeof(int));
+  int *elem_displs = malloc(size * sizeof(int));
+  int *chunk_rows = malloc(C * size * sizeof(int));  // [k * size + p]: linhas do pedaço k do processo p
+  int *chunk_rdisp = malloc(C * size * sizeof(int)); // Deslocamento do pedaço (em linhas) em A e y
+  int *chunk_elems = malloc(C * size * sizeof(int));
+  int *chunk_edisp = malloc(C * size * sizeof(int));
+  for (int p = 0; p < size; p++){
+    row_counts[p] = block_size(M, size, p);
+    row_displs[p] = block_start(M, size, p);
+    elem_counts[p] = row_counts[p] * N;
+    elem_displs[p] = row_displs[p] * N;
+    for (int k = 0; k < C; k++){
+      chunk_rows[k * size + p] = block_size(row_counts[p], C, k);
+      chunk_rdisp[k * size + p] = row_displs[p] + block_start(row_counts[p], C, k);
+      chunk_elems[k * size + p] = chunk_rows[k * size + p] * N;
+      chunk_edisp[k * size + p] = chunk_rdisp[k * size + p] * N;
+    }
+  }
+
+  double *A = NULL; // Matriz (só no processo 0)
+  double *x = malloc(N * sizeof(double));
+  double *local_A = malloc(((size_t)local_rows * N + 1) * sizeof(double));
+  double *local_y = malloc((local_rows + 1) * sizeof(double));
+  double *y = NULL; // Vetor resultante completo (só no processo 0)
+  double *y_block = NULL; // Resultado da versão bloqueante
+  double *y_ref = NULL;   // Referência sequencial
+
+  if (rank == 0){
+    A = malloc((size_t)M * N * sizeof(double));
+    y = malloc(M * sizeof(double));
+    y_block = malloc(M * sizeof(double));
+    y_ref = malloc(M * sizeof(double));
+    poison(y_block, M);
+    srand(time(NULL));
+    fill_matrix(A, M, N);
+    fill_vector(x, N);
+    multiply_rows(A, x, y_ref, M, N);
+  }
+  else {
+    poison(x, N);
+  }
+  poison(local_A, (size_t)local_rows * N);
+  poison(local_y, local_rows);
+
+  // --- Versão bloqueante (referência): Bcast, Scatterv, cálculo, Gatherv em sequência ---
+  MPI_Barrier(MPI_COMM_WORLD);
+  double t0 = MPI_Wtime();
+  MPI_Bcast(x, N, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  MPI_Scatterv(A, elem_counts, elem_displs, MPI_DOUBLE,
+               local_A, local_rows * N, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  double t1 = MPI_Wtime();
+  multiply_rows(local_A, x, local_y, local_rows, N);
+  double t2 = MPI_Wtime();
+  MPI_Gatherv(local_y, local_rows, MPI_DOUBLE,
+              y_block, row_counts, row_displs, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  double t3 = MPI_Wtime();
+  double block_comm = (t1 - t0) + (t3 - t2);
+  double block_compute = t2 - t1;
+  double block_total = t3 - t0;
+
+  // --- Versão com pipeline, a partir de buffers envenenados de novo ---
+  if (rank == 0)
+    poison(y, M);
+  else
+    poison(x, N);
+  poison(local_A, (size_t)local_rows * N);
+  poison(local_y, local_rows);
+
+  MPI_Request x_req;
+  MPI_Request *scatter_reqs = malloc(C * sizeof(MPI_Request));
+  MPI_Request *gather_reqs = malloc(C * sizeof(MPI_Request));
+  double wait_time = 0.0, compute_time = 0.0;
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start_time = MPI_Wtime();
+
+  // x e o primeiro pedaço de A partem juntos
+  MPI_Ibcast(x, N, MPI_DOUBLE, 0, MPI_COMM_WORLD, &x_req);
+  MPI_Iscatterv(A, chunk_elems, chunk_edisp, MPI_DOUBLE,
+                local_A, chunk_elems[rank], MPI_DOUBLE, 0, MPI_COMM_WORLD, &scatter_reqs[0]);
+
+  for (int k = 0; k < C; k++){
+    int my_first_row = block_start(local_rows, C, k);
+
+    // Posta o pedaço k+1 antes de calcular o pedaço k
+    if (k + 1 < C){
+      int next_first_row = block_start(local_rows, C, k + 1);
+      MPI_Iscatterv(A, chunk_elems + (k + 1) * size, chunk_edisp + (k + 1) * size, MPI_DOUBLE,
+                    local_A + (size_t)next_first_row * N, chunk_elems[(k + 1) * size + rank], MPI_DOUBLE,
+                    0, MPI_COMM_WORLD, &scatter_reqs[k + 1]);
+    }
+
+    double w0 = MPI_Wtime();
+    if (k == 0)
+      MPI_Wait(&x_req, MPI_STATUS_IGNORE);
+    MPI_Wait(&scatter_reqs[k], MPI_STATUS_IGNORE);
+    double c0 = MPI_Wtime();
+    wait_time += c0 - w0;
+
+    multiply_rows(local_A + (size_t)my_first_row * N, x, local_y + my_first_row,
+                  chunk_rows[k * size + rank], N);
+    compute_time += MPI_Wtime() - c0;
+
+    // O pedaço k de y já pode voltar
+    MPI_Igatherv(local_y + my_first_row, chunk_rows[k * size + rank], MPI_DOUBLE,
+                 y, chunk_rows + k * size, chunk_rdisp + k * size, MPI_DOUBLE,
+                 0, MPI_COMM_WORLD, &gather_reqs[k]);
+  }
+
+  double w0 = MPI_Wtime();
+  MPI_Waitall(C, gather_reqs, MPI_STATUSES_IGNORE);
+  double end_time = MPI_Wtime();
+  wait_time += end_time - w0;
+  double elapsed = end_time - start_time;
+
+  // Cada métrica vem de uma única execução. A fração exposta é calculada no próprio processo
+  // (comunicação ou espera / total da mesma execução), e depois vale a do processo mais lento.
+  double local_times[8] = {block_total, block_comm, block_compute, block_comm / block_total,
+                           elapsed, wait_time, compute_time, wait_time / elapsed};
+  double max_times[8];
+  MPI_Reduce(local_times, max_times, 8, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+  // Divisão por processo: comunicação, cálculo e sobreposição (comunicação escondida pelo pipeline)
+  double overlap = block_comm - wait_time;
+  double local_split[4] = {block_comm, compute_time, wait_time, overlap};
+  double *split = rank == 0 ? malloc(4 * size * sizeof(double)) : NULL;
+  MPI_Gather(local_split, 4, MPI_DOUBLE, split, 4, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  if (rank == 0){
+    int block_errors = 0, pipe_errors = 0;
+    for (int i = 0; i < M; i++){
+      if (!(y_block[i] == y_ref[i]))
+        block_errors++;
+      if (!(y[i] == y_ref[i]))
+        pipe_errors++;
+    }
+
+    printf("Matriz %dX%d com %d processos e %d pedaços\n", M, N, size, C);
+    printf("%8s %14s %12s %12s %14s %12s\n", "processo", "comunicação", "cálculo", "espera",
+           "sobreposição", "escondida");
+    for (int p = 0; p < size; p++){
+      const double *t = split + 4 * p;
+      printf("%8d %14f %12f %12f %14f %11.1f%%\n", p, t[0], t[1], t[2], t[3],
+             t[0] > 0 ? 100.0 * t[3] / t[0] : 0.0);
+    }
+    printf("Bloqueante: total %f s, comunicação %f s, cálculo %f s (comunicação exposta: %.1f%%)\n",
+           max_times[0], max_times[1], max_times[2], 100.0 * max_times[3]);
+    printf("Pipeline:   total %f s, espera por comunicação %f s, cálculo %f s (comunicação exposta: %.1f%%)\n",
+           max_times[4], max_times[5], max_times[6], 100.0 * max_times[7]);
+    printf("Linhas divergentes da referência sequencial: bloqueante %d, pipeline %d\n",
+           block_errors, pipe_errors);
+    free(split);
+  }
+
+  free(scatter_reqs);
+  free(gather_reqs);
+  free(row_counts);
+  free(row_displs);
+  free(elem_counts);
+  free(elem_displs);
+  free(chunk_rows);
+  free(chunk_rdisp);
+  free(chunk_elems);
+  free(chunk_edisp);
+  free(local_A);
+  free(local_y);
+  free(x);
+  if (rank == 0){
+    free(A);
+    free(y);
+    free(y_block);
+    free(y_ref);
+  }
+
+  MPI_Finalize();
+  return 0;
+}
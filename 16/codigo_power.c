@@ -0,0 +1,148 @@
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+// Método da potência com a matriz distribuída por linhas e mantida nos processos.
+// A é espalhada uma única vez; a cada iteração cada processo calcula suas linhas de y = A * x,
+// a norma sai de um MPI_Allreduce e o novo x é montado em todos com MPI_Allgatherv.
+// Só o vetor circula por iteração, então o custo de distribuir A é pago uma vez.
+// Uso: mpirun -np <p> ./codigo_power [N] [máximo de iterações] [tolerância]
+
+void fill_matrix(double *A, int rows, int cols){
+  for (int i = 0; i < rows * cols; i++)
+    A[i] = rand() % 10;
+}
+
+// Tamanho e início do bloco idx quando n elementos são divididos em p blocos
+int block_size(int n, int p, int idx){
+  return n / p + (idx < n % p ? 1 : 0);
+}
+
+int block_start(int n, int p, int idx){
+  return idx * (n / p) + (idx < n % p ? idx : n % p);
+}
+
+int main(int argc, char *argv[]){
+  int rank, size;
+  int N = argc > 1 ? atoi(argv[1]) : 8;           // Matriz N x N
+  int max_iter = argc > 2 ? atoi(argv[2]) : 1000; // Máximo de iterações
+  double tol = argc > 3 ? atof(argv[3]) : 1e-10;  // Critério de parada relativo no autovalor
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (N <= 0 || max_iter <= 0 || tol <= 0.0){
+    if (rank == 0)
+      fprintf(stderr, "N (%d), iterações (%d) e tolerância (%g) devem ser positivos\n", N, max_iter, tol);
+    MPI_Finalize();
+    return 1;
+  }
+
+  int *row_counts = malloc(size * sizeof(int));
+  int *row_displs = malloc(size * sizeof(int));
+  int *elem_counts = malloc(size * sizeof(int));
+  int *elem_displs = malloc(size * sizeof(int));
+  for (int p = 0; p < size; p++){
+    row_counts[p] = block_size(N, size, p);
+    row_displs[p] = block_start(N, size, p);
+    elem_counts[p] = row_counts[p] * N;
+    elem_displs[p] = row_displs[p] * N;
+  }
+  int local_rows = row_counts[rank];
+
+  double *A = NULL;
+  double *x = malloc(N * sizeof(double));
+  double *local_A = malloc(((size_t)local_rows * N + 1) * sizeof(double));
+  double *local_y = malloc((local_rows + 1) * sizeof(double));
+  double *iter_times = malloc(max_iter * sizeof(double));
+
+  if (rank == 0){
+    A = malloc((size_t)N * N * sizeof(double));
+    srand(time(NULL));
+    fill_matrix(A, N, N);
+  }
+
+  // --- Distribuição (uma única vez) ---
+  double dist_start = MPI_Wtime();
+  MPI_Scatterv(A, elem_counts, elem_displs, MPI_DOUBLE,
+               local_A, local_rows * N, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  double dist_time = MPI_Wtime() - dist_start;
+
+  for (int i = 0; i < N; i++)
+    x[i] = 1.0 / sqrt((double)N); // Vetor inicial normalizado, igual em todos os processos
+
+  // --- Iterações: só o vetor é comunicado ---
+  double lambda = 0.0, lambda_old = 0.0;
+  int iter = 0, converged = 0, null_vector = 0;
+  double loop_start = MPI_Wtime();
+
+  while (iter < max_iter && !converged){
+    double t0 = MPI_Wtime();
+
+    double local_norm2 = 0.0;
+    for (int i = 0; i < local_rows; i++){
+      double sum = 0.0;
+      for (int j = 0; j < N; j++){
+        sum += local_A[i * N + j] * x[j];
+      }
+      local_y[i] = sum;
+      local_norm2 += sum * sum;
+    }
+
+    double norm2;
+    MPI_Allreduce(&local_norm2, &norm2, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    lambda = sqrt(norm2); // ||A x|| com ||x|| = 1 converge para |λ_max|
+    if (norm2 == 0.0){ // A x = 0: não há como normalizar (norm2 é o mesmo em todos os processos)
+      null_vector = 1;
+      iter_times[iter++] = MPI_Wtime() - t0;
+      break;
+    }
+
+    for (int i = 0; i < local_rows; i++)
+      local_y[i] /= lambda;
+
+    MPI_Allgatherv(local_y, local_rows, MPI_DOUBLE,
+                   x, row_counts, row_displs, MPI_DOUBLE, MPI_COMM_WORLD);
+
+    converged = iter > 0 && fabs(lambda - lambda_old) <= tol * fabs(lambda);
+    lambda_old = lambda;
+    iter_times[iter++] = MPI_Wtime() - t0;
+  }
+
+  double loop_time = MPI_Wtime() - loop_start;
+
+  if (rank == 0){
+    double min_t = iter_times[0], max_t = iter_times[0];
+    for (int k = 1; k < iter; k++){
+      if (iter_times[k] < min_t) min_t = iter_times[k];
+      if (iter_times[k] > max_t) max_t = iter_times[k];
+    }
+
+    printf("Método da potência com %d processos e Matriz %dX%d (dist. por linhas)\n", size, N, N);
+    if (null_vector)
+      printf("A x = 0 na iteração %d: x está no núcleo de A e o método da potência não pode continuar\n", iter);
+    else
+      printf("Autovalor dominante: %.12f (%s em %d iterações)\n", lambda,
+             converged ? "convergiu" : "não convergiu", iter);
+    printf("Distribuição de A (uma vez): %f segundos\n", dist_time);
+    printf("Iterações: %f segundos no total, por iteração média %f / mín %f / máx %f segundos\n",
+           loop_time, loop_time / iter, min_t, max_t);
+  }
+
+  free(row_counts);
+  free(row_displs);
+  free(elem_counts);
+  free(elem_displs);
+  free(local_A);
+  free(local_y);
+  free(iter_times);
+  free(x);
+  if (rank == 0)
+    free(A);
+
+  MPI_Finalize();
+  return null_vector;
+}
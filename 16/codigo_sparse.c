@@ -0,0 +1,200 @@
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "../01intro/matrix_market.h"
+
+// Distribuição por linhas com a matriz esparsa em CSR (SpMV).
+// Só os não-zeros (valor + coluna) e os ponteiros de linha são enviados, e as linhas são
+// divididas com MPI_Scatterv/MPI_Gatherv, então M não precisa ser divisível pelo número de processos.
+// CSRMatrix e o leitor de Matrix Market são os de 01intro/matrix_market.h.
+// Uso: mpirun -np <p> ./codigo_sparse [M] [N] [densidade]
+//      mpirun -np <p> ./codigo_sparse -f <arquivo.mtx>
+
+// Matriz aleatória com a densidade pedida e valores rand() % 10 + 1 (como fill_matrix, sem zeros)
+int fill_sparse_matrix(CSRMatrix *A, int rows, int cols, double density){
+  long capacity = (long)(density * rows * cols * 1.1) + rows + 16;
+  A->rows = rows;
+  A->cols = cols;
+  A->row_ptr = malloc((rows + 1) * sizeof(long));
+  A->col = malloc(capacity * sizeof(int));
+  A->val = malloc(capacity * sizeof(double));
+  if (A->row_ptr == NULL || A->col == NULL || A->val == NULL){
+    freeCSR(A);
+    return 1;
+  }
+
+  long nnz = 0;
+  A->row_ptr[0] = 0;
+  for (int i = 0; i < rows; i++){
+    for (int j = 0; j < cols; j++){
+      if ((double)rand() / RAND_MAX < density){
+        if (nnz == capacity){
+          capacity *= 2;
+          // Ponteiros temporários: se o realloc falhar, o bloco antigo continua em A e é liberado
+          int *col = realloc(A->col, capacity * sizeof(int));
+          if (col != NULL) A->col = col;
+          double *val = col != NULL ? realloc(A->val, capacity * sizeof(double)) : NULL;
+          if (val != NULL) A->val = val;
+          if (col == NULL || val == NULL){
+            freeCSR(A);
+            return 1;
+          }
+        }
+        A->col[nnz] = j;
+        A->val[nnz] = rand() % 10 + 1;
+        nnz++;
+      }
+    }
+    A->row_ptr[i + 1] = nnz;
+  }
+  A->nnz = nnz;
+  return 0;
+}
+
+void fill_vector(double *x, int size){
+  for (int i = 0; i < size; i++)
+    x[i] = rand() % 10;
+}
+
+int main(int argc, char *argv[]){
+  int rank, size;
+  CSRMatrix A = {0};
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  // O processo 0 monta a matriz inteira e avisa os demais se deu certo
+  int dims[3] = {0, 0, 0}; // M, N, erro
+  if (rank == 0){
+    srand(time(NULL));
+    int err;
+    if (argc == 3 && strcmp(argv[1], "-f") == 0){
+      err = loadMatrixMarket(argv[2], &A);
+    } else {
+      int M = argc > 1 ? atoi(argv[1]) : 8;
+      int N = argc > 2 ? atoi(argv[2]) : 4;
+      double density = argc > 3 ? atof(argv[3]) : 0.05;
+      err = M <= 0 || N <= 0 || density <= 0.0 || density > 1.0 || fill_sparse_matrix(&A, M, N, density);
+    }
+    // Contagens e deslocamentos do MPI_Scatterv são int
+    if (!err && A.nnz > INT_MAX){
+      fprintf(stderr, "Não-zeros demais (%ld) para o MPI_Scatterv\n", A.nnz);
+      err = 1;
+    }
+    if (err)
+      fprintf(stderr, "Não foi possível montar a matriz esparsa\n");
+    dims[0] = A.rows;
+    dims[1] = A.cols;
+    dims[2] = err;
+  }
+  MPI_Bcast(dims, 3, MPI_INT, 0, MPI_COMM_WORLD);
+  if (dims[2]){
+    MPI_Finalize();
+    return 1;
+  }
+  int M = dims[0], N = dims[1];
+
+  // Divisão das linhas: os primeiros M % size processos ficam com uma linha a mais
+  int *row_counts = malloc(size * sizeof(int));
+  int *row_displs = malloc(size * sizeof(int));
+  for (int p = 0; p < size; p++){
+    row_counts[p] = M / size + (p < M % size ? 1 : 0);
+    row_displs[p] = p == 0 ? 0 : row_displs[p - 1] + row_counts[p - 1];
+  }
+  int local_rows = row_counts[rank];
+
+  // Quantidade de não-zeros de cada processo, calculada pelo processo 0
+  int *nnz_counts = malloc(size * sizeof(int));
+  int *nnz_displs = malloc(size * sizeof(int));
+  if (rank == 0){
+    for (int p = 0; p < size; p++){
+      nnz_displs[p] = (int)A.row_ptr[row_displs[p]];
+      nnz_counts[p] = (int)(A.row_ptr[row_displs[p] + row_counts[p]] - A.row_ptr[row_displs[p]]);
+    }
+  }
+
+  double *x = malloc(N * sizeof(double));
+  double *y = NULL;
+  if (rank == 0){
+    y = malloc(M * sizeof(double));
+    fill_vector(x, N);
+  }
+
+  // Medição de tempo começa aqui
+  double start_time = MPI_Wtime();
+
+  int local_nnz;
+  MPI_Scatter(nnz_counts, 1, MPI_INT, &local_nnz, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+  long *local_row_ptr = malloc((local_rows + 1) * sizeof(long));
+  int *local_col = malloc((local_nnz + 1) * sizeof(int));
+  double *local_val = malloc((local_nnz + 1) * sizeof(double));
+  double *local_y = malloc((local_rows + 1) * sizeof(double));
+
+  MPI_Bcast(x, N, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  // row_ptr vai com os índices globais e é deslocado localmente para começar em 0
+  MPI_Scatterv(A.row_ptr, row_counts, row_displs, MPI_LONG,
+               local_row_ptr, local_rows, MPI_LONG, 0, MPI_COMM_WORLD);
+  MPI_Scatterv(A.col, nnz_counts, nnz_displs, MPI_INT,
+               local_col, local_nnz, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Scatterv(A.val, nnz_counts, nnz_displs, MPI_DOUBLE,
+               local_val, local_nnz, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  long offset = local_rows > 0 ? local_row_ptr[0] : 0;
+  for (int i = 0; i < local_rows; i++)
+    local_row_ptr[i] -= offset;
+  local_row_ptr[local_rows] = local_nnz;
+
+  for (int i = 0; i < local_rows; i++){
+    double sum = 0.0;
+    for (long k = local_row_ptr[i]; k < local_row_ptr[i + 1]; k++){
+      sum += local_val[k] * x[local_col[k]];
+    }
+    local_y[i] = sum;
+  }
+
+  MPI_Gatherv(local_y, local_rows, MPI_DOUBLE,
+              y, row_counts, row_displs, MPI_DOUBLE,
+              0, MPI_COMM_WORLD);
+
+  double end_time = MPI_Wtime();
+  double elapsed = end_time - start_time;
+
+  if (rank == 0){
+    // Conferência com o SpMV sequencial
+    int errors = 0;
+    for (int i = 0; i < M; i++){
+      double sum = 0.0;
+      for (long k = A.row_ptr[i]; k < A.row_ptr[i + 1]; k++)
+        sum += A.val[k] * x[A.col[k]];
+      if (sum != y[i])
+        errors++;
+    }
+
+    printf("Tempo total de execução com %d processos e Matriz esparsa %dX%d (%ld não-zeros): %f segundos\n",
+           size, M, N, A.nnz, elapsed);
+    printf("Linhas divergentes: %d\n", errors);
+  }
+
+  free(local_row_ptr);
+  free(local_col);
+  free(local_val);
+  free(local_y);
+  free(row_counts);
+  free(row_displs);
+  free(nnz_counts);
+  free(nnz_displs);
+  free(x);
+  if (rank == 0){
+    freeCSR(&A);
+    free(y);
+  }
+
+  MPI_Finalize();
+  return 0;
+}
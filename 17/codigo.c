@@ -27,6 +27,7 @@ int main(int argc, char *argv[]){
     if (rank == 0)
       fprintf(stderr, "N (%d) deve ser divisível pelo número de processos (%d)\n", N, size);
     MPI_Finalize();
+    return 1;
   }
 
   int local_cols = N / size; // Número de colunas por processo
@@ -0,0 +1,208 @@
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+
+// Distribuição 2D da matriz numa grade de processos Pr x Pc (MPI_Cart_create).
+// O processo (r, c) fica com o bloco de linhas r e o bloco de colunas c de A, e só precisa do
+// pedaço c de x. Em vez de O(N) por processo (codigo.c de 16 e 17), cada processo recebe e
+// envia O(N/√P) elementos dos vetores: x chega pela comunicadora de coluna e y é reduzido
+// pela comunicadora de linha. Os blocos podem ter tamanhos diferentes (MPI_Scatterv/Gatherv),
+// então M e N não precisam ser divisíveis pelo número de processos.
+// Uso: mpirun -np <p> ./codigo_2d [M] [N]
+
+void fill_matrix(double *A, int rows, int cols){
+  for (size_t i = 0; i < (size_t)rows * cols; i++)
+    A[i] = (double)(rand() % 10);
+}
+
+void fill_vector(double *x, int size){
+  for (int i = 0; i < size; i++)
+    x[i] = (double)(rand() % 10);
+}
+
+// Tamanho e início do bloco idx quando n elementos são divididos em p blocos
+int block_size(int n, int p, int idx){
+  return n / p + (idx < n % p ? 1 : 0);
+}
+
+int block_start(int n, int p, int idx){
+  return idx * (n / p) + (idx < n % p ? idx : n % p);
+}
+
+int main(int argc, char *argv[]){
+  int rank, size;
+  int M = argc > 1 ? atoi(argv[1]) : 8; // Número total de linhas da matriz
+  int N = argc > 2 ? atoi(argv[2]) : 4; // Número de colunas da matriz = tamanho do vetor x
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (M <= 0 || N <= 0){
+    if (rank == 0)
+      fprintf(stderr, "M (%d) e N (%d) devem ser positivos\n", M, N);
+    MPI_Finalize();
+    return 1;
+  }
+
+  // As contagens e deslocamentos das chamadas MPI são int; o maior deslocamento + contagem é M * N
+  if ((size_t)M * N > INT_MAX){
+    if (rank == 0)
+      fprintf(stderr, "Matriz grande demais para as contagens int do MPI\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  // --- Grade de processos e sub-comunicadoras ---
+  int dims[2] = {0, 0}, periods[2] = {0, 0}, coords[2];
+  MPI_Dims_create(size, 2, dims); // Grade o mais quadrada possível
+  MPI_Comm grid_comm, row_comm, col_comm;
+  MPI_Cart_create(MPI_COMM_WORLD, 2, dims, periods, 0, &grid_comm); // Sem reordenar: rank 0 = (0, 0)
+  MPI_Cart_coords(grid_comm, rank, 2, coords);
+
+  int keep_cols[2] = {0, 1}; // Mesma linha da grade, varia a coluna
+  int keep_rows[2] = {1, 0}; // Mesma coluna da grade, varia a linha
+  MPI_Cart_sub(grid_comm, keep_cols, &row_comm);
+  MPI_Cart_sub(grid_comm, keep_rows, &col_comm);
+
+  int Pr = dims[0], Pc = dims[1];
+  int my_row = coords[0], my_col = coords[1];
+  int local_rows = block_size(M, Pr, my_row);
+  int local_cols = block_size(N, Pc, my_col);
+
+  // Contagens e deslocamentos dos blocos de linhas (na coluna 0 da grade) e de colunas (em cada linha)
+  int *row_counts = malloc(Pr * sizeof(int));
+  int *row_displs = malloc(Pr * sizeof(int));
+  int *row_elem_counts = malloc(Pr * sizeof(int));
+  int *row_elem_displs = malloc(Pr * sizeof(int));
+  int *col_counts = malloc(Pc * sizeof(int));
+  int *col_displs = malloc(Pc * sizeof(int));
+  for (int r = 0; r < Pr; r++){
+    row_counts[r] = block_size(M, Pr, r);
+    row_displs[r] = block_start(M, Pr, r);
+    row_elem_counts[r] = row_counts[r] * N;
+    row_elem_displs[r] = row_displs[r] * N;
+  }
+  for (int c = 0; c < Pc; c++){
+    col_counts[c] = block_size(N, Pc, c);
+    col_displs[c] = block_start(N, Pc, c);
+  }
+
+  double *A = NULL;
+  double *x = NULL;
+  double *y = NULL;
+  double *row_block = NULL; // Faixa de linhas completa (só na coluna 0 da grade)
+  double *local_A = malloc(((size_t)local_rows * local_cols + 1) * sizeof(double));
+  double *x_block = malloc((local_cols + 1) * sizeof(double));
+  double *local_y = calloc(local_rows + 1, sizeof(double));
+  double *reduced_y = NULL;
+
+  if (rank == 0){
+    A = (double *)malloc((size_t)M * N * sizeof(double));
+    x = (double *)malloc(N * sizeof(double));
+    y = (double *)malloc(M * sizeof(double));
+    srand(time(NULL));
+    fill_matrix(A, M, N);
+    fill_vector(x, N);
+  }
+  if (my_col == 0){
+    row_block = malloc(((size_t)local_rows * N + 1) * sizeof(double));
+    reduced_y = malloc((local_rows + 1) * sizeof(double));
+  }
+
+  // Tipo de uma coluna da faixa de linhas (local_rows elementos com passo N), redimensionado para
+  // 1 double: assim os deslocamentos do Scatterv são contados em colunas.
+  MPI_Datatype col_type, resized_col_type, tile_col_type, resized_tile_col_type;
+  MPI_Type_vector(local_rows, 1, N, MPI_DOUBLE, &col_type);
+  MPI_Type_create_resized(col_type, 0, sizeof(double), &resized_col_type);
+  MPI_Type_commit(&resized_col_type);
+  // O mesmo do lado de quem recebe, com passo local_cols, para o bloco ficar em ordem de linhas
+  MPI_Type_vector(local_rows, 1, local_cols > 0 ? local_cols : 1, MPI_DOUBLE, &tile_col_type);
+  MPI_Type_create_resized(tile_col_type, 0, sizeof(double), &resized_tile_col_type);
+  MPI_Type_commit(&resized_tile_col_type);
+
+  // Medição de tempo começa aqui
+  double start_time = MPI_Wtime();
+
+  // 1. Faixas de linhas de A para a coluna 0 da grade (contíguas, tamanhos desiguais)
+  if (my_col == 0)
+    MPI_Scatterv(A, row_elem_counts, row_elem_displs, MPI_DOUBLE,
+                 row_block, local_rows * N, MPI_DOUBLE, 0, col_comm);
+
+  // 2. Cada faixa é dividida em blocos de colunas ao longo da linha da grade
+  MPI_Scatterv(row_block, col_counts, col_displs, resized_col_type,
+               local_A, local_cols, resized_tile_col_type, 0, row_comm);
+
+  // 3. Pedaços de x: primeiro para a linha 0 da grade, depois Bcast em cada coluna da grade
+  if (my_row == 0)
+    MPI_Scatterv(x, col_counts, col_displs, MPI_DOUBLE,
+                 x_block, local_cols, MPI_DOUBLE, 0, row_comm);
+  MPI_Bcast(x_block, local_cols, MPI_DOUBLE, 0, col_comm);
+
+  // 4. Produto do bloco local: contribuição parcial para as linhas do bloco
+  for (int i = 0; i < local_rows; i++){
+    double sum = 0.0;
+    for (int j = 0; j < local_cols; j++){
+      sum += local_A[(size_t)i * local_cols + j] * x_block[j];
+    }
+    local_y[i] = sum;
+  }
+
+  // 5. Soma das contribuições ao longo da linha da grade, depois junta os blocos de y na coluna 0
+  MPI_Reduce(local_y, reduced_y, local_rows, MPI_DOUBLE, MPI_SUM, 0, row_comm);
+  if (my_col == 0)
+    MPI_Gatherv(reduced_y, local_rows, MPI_DOUBLE,
+                y, row_counts, row_displs, MPI_DOUBLE, 0, col_comm);
+
+  double end_time = MPI_Wtime();
+  double elapsed = end_time - start_time;
+
+  if (rank == 0){
+    // Conferência com o produto sequencial (valores inteiros: a soma é exata em qualquer ordem)
+    int errors = 0;
+    for (int i = 0; i < M; i++){
+      double sum = 0.0;
+      for (int j = 0; j < N; j++)
+        sum += A[(size_t)i * N + j] * x[j];
+      if (sum != y[i])
+        errors++;
+    }
+
+    printf("Tempo total de execução com %d processos (grade %dx%d) e Matriz %dX%d: %f segundos\n",
+           size, Pr, Pc, M, N, elapsed);
+    printf("Elementos de vetor por processo: ~%d de x e ~%d de y (contra %d e %d na distribuição 1D)\n",
+           (N + Pc - 1) / Pc, (M + Pr - 1) / Pr, N, M);
+    printf("Linhas divergentes: %d\n", errors);
+  }
+
+  free(local_A);
+  free(x_block);
+  free(local_y);
+  free(row_counts);
+  free(row_displs);
+  free(row_elem_counts);
+  free(row_elem_displs);
+  free(col_counts);
+  free(col_displs);
+  if (my_col == 0){
+    free(row_block);
+    free(reduced_y);
+  }
+  if (rank == 0){
+    free(A);
+    free(x);
+    free(y);
+  }
+
+  MPI_Type_free(&col_type);
+  MPI_Type_free(&resized_col_type);
+  MPI_Type_free(&tile_col_type);
+  MPI_Type_free(&resized_tile_col_type);
+  MPI_Comm_free(&row_comm);
+  MPI_Comm_free(&col_comm);
+  MPI_Comm_free(&grid_comm);
+  MPI_Finalize();
+  return 0;
+}
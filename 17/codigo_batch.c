@@ -0,0 +1,163 @@
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+// Versão em lote da distribuição por colunas: Y = A * X, onde X reúne K vetores.
+// Cada processo lê seu bloco de colunas uma única vez para os K vetores.
+// X tem N x K elementos (linha j = elemento j dos K vetores), então o bloco de linhas
+// de X correspondente às colunas locais é contíguo e vai com um MPI_Scatter simples.
+// Mede K = 1, 2, 4, ... até o K dado, e o processo 0 confere cada Y contra o produto sequencial.
+// Uso: mpirun -np <p> ./codigo_batch [M] [N] [K máximo]
+
+void fill_matrix(double *A, int rows, int cols){
+  for (size_t i = 0; i < (size_t)rows * cols; i++)
+    A[i] = (double)(rand() % 10);
+}
+
+void fill_vector(double *x, size_t size){
+  for (size_t i = 0; i < size; i++)
+    x[i] = (double)(rand() % 10);
+}
+
+// local_Y[i][0..K) += soma_j local_A[i][j] * local_X[j][0..K)
+void multiply_batched(const double *local_A, const double *local_X, double *local_Y,
+                      int M, int local_cols, int K){
+  for (int i = 0; i < M; i++){
+    double *y = local_Y + (size_t)i * K;
+    for (int j = 0; j < local_cols; j++){
+      double a = local_A[(size_t)i * local_cols + j];
+      const double *x = local_X + (size_t)j * K;
+      #pragma omp simd
+      for (int k = 0; k < K; k++)
+        y[k] += a * x[k];
+    }
+  }
+}
+
+// Conferência no processo 0: Y contra o produto sequencial, um vetor por vez
+int count_errors(const double *A, const double *X, const double *Y, int M, int N, int K){
+  int errors = 0;
+  for (int k = 0; k < K; k++){
+    for (int i = 0; i < M; i++){
+      double sum = 0.0;
+      for (int j = 0; j < N; j++)
+        sum += A[(size_t)i * N + j] * X[(size_t)j * K + k];
+      if (Y[(size_t)i * K + k] != sum) errors++; // Inteiros pequenos: soma exata em qualquer ordem
+    }
+  }
+  return errors;
+}
+
+int main(int argc, char *argv[]){
+  int rank, size;
+  int M = argc > 1 ? atoi(argv[1]) : 8; // Número total de linhas da matriz
+  int N = argc > 2 ? atoi(argv[2]) : 4; // Número de colunas da matriz = tamanho de cada vetor
+  int max_K = argc > 3 ? atoi(argv[3]) : 8; // Maior lote; mede K = 1, 2, 4, ... até ele
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (M <= 0 || N <= 0 || max_K <= 0 || N % size != 0){
+    if (rank == 0)
+      fprintf(stderr, "N (%d) deve ser divisível pelo número de processos (%d), e M, N, K positivos\n", N, size);
+    MPI_Finalize();
+    return 1;
+  }
+
+  int local_cols = N / size;
+
+  // As contagens das chamadas MPI são int
+  if ((size_t)M * local_cols > INT_MAX || (size_t)local_cols * max_K > INT_MAX || (size_t)M * max_K > INT_MAX){
+    if (rank == 0)
+      fprintf(stderr, "Blocos grandes demais para as contagens int do MPI\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  double *A = NULL;
+  double *X = NULL;
+  double *Y = NULL;
+
+  double *local_A = (double *)malloc((size_t)M * local_cols * sizeof(double));
+  double *local_X = (double *)malloc((size_t)local_cols * max_K * sizeof(double));
+  double *local_Y = (double *)malloc((size_t)M * max_K * sizeof(double)); // Contribuição parcial para Y
+
+  if (rank == 0){
+    A = (double *)malloc((size_t)M * N * sizeof(double));
+    X = (double *)malloc((size_t)N * max_K * sizeof(double));
+    Y = (double *)malloc((size_t)M * max_K * sizeof(double));
+    srand(time(NULL));
+    fill_matrix(A, M, N);
+  }
+
+  // Mesmo tipo derivado de codigo.c para enviar blocos de colunas
+  MPI_Datatype col_type, resized_col_type;
+  MPI_Type_vector(M, local_cols, N, MPI_DOUBLE, &col_type);
+  MPI_Type_commit(&col_type);
+  MPI_Type_create_resized(col_type, 0, local_cols * sizeof(double), &resized_col_type);
+  MPI_Type_commit(&resized_col_type);
+
+  int ok = 1;
+  if (rank == 0){
+    printf("Processos: %d (dist. por colunas), Matriz %dX%d\n", size, M, N);
+    printf("%4s %14s %14s %12s %12s %s\n", "K", "total (s)", "s por vetor", "cálculo (s)", "GFLOP/s", "conferência");
+  }
+
+  for (int K = 1; ; K = 2 * K < max_K ? 2 * K : max_K){
+    if (rank == 0)
+      fill_vector(X, (size_t)N * K);
+    memset(local_Y, 0, (size_t)M * K * sizeof(double));
+
+    // Medição de tempo começa aqui
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start_time = MPI_Wtime();
+
+    MPI_Scatter(A, 1, resized_col_type,
+                local_A, M * local_cols, MPI_DOUBLE,
+                0, MPI_COMM_WORLD);
+
+    MPI_Scatter(X, local_cols * K, MPI_DOUBLE,
+                local_X, local_cols * K, MPI_DOUBLE,
+                0, MPI_COMM_WORLD);
+
+    double compute_start = MPI_Wtime();
+    multiply_batched(local_A, local_X, local_Y, M, local_cols, K);
+    double compute_time = MPI_Wtime() - compute_start;
+
+    // Soma as contribuições parciais dos K vetores de uma vez
+    MPI_Reduce(local_Y, Y, M * K, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    double end_time = MPI_Wtime();
+    double elapsed = end_time - start_time;
+
+    double max_compute;
+    MPI_Reduce(&compute_time, &max_compute, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0){
+      int errors = count_errors(A, X, Y, M, N, K);
+      if (errors) ok = 0;
+      printf("%4d %14f %14f %12f %12.2f %s\n", K, elapsed, elapsed / K, max_compute,
+             2.0 * M * N * K / max_compute / 1e9, errors == 0 ? "ok" : "ERRO");
+    }
+
+    if (K == max_K) break;
+  }
+
+  free(local_A);
+  free(local_X);
+  free(local_Y);
+  if (rank == 0){
+    free(A);
+    free(X);
+    free(Y);
+  }
+
+  MPI_Type_free(&col_type);
+  MPI_Type_free(&resized_col_type);
+  MPI_Finalize();
+  return ok ? 0 : 1;
+}
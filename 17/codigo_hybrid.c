@@ -0,0 +1,151 @@
+#include <mpi.h>
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+
+// Versão híbrida MPI + OpenMP da distribuição por colunas.
+// Um processo por socket com o bloco de colunas local calculado pelas threads OpenMP: cada thread
+// fica com um conjunto de linhas de local_y, então não há disputa na escrita. Só a thread
+// principal chama o MPI (MPI_THREAD_FUNNELED).
+// Compilar com: mpicc -O3 -march=native -fopenmp codigo_hybrid.c -o codigo_hybrid
+// Comparação no mesmo número de nós (ex.: 2 sockets x 16 núcleos):
+//   MPI puro: OMP_NUM_THREADS=1  mpirun -np 32 --bind-to core ./codigo_hybrid M N
+//   Híbrido:  OMP_NUM_THREADS=16 mpirun -np 2 --map-by socket --bind-to socket ./codigo_hybrid M N
+// O processo 0 confere y contra o produto sequencial; a última linha impressa tem formato CSV
+// para montar a tabela de escalabilidade.
+
+void fill_matrix(double *A, int rows, int cols){
+  for (size_t i = 0; i < (size_t)rows * cols; i++)
+    A[i] = (double)(rand() % 10);
+}
+
+void fill_vector(double *x, int size){
+  for (int i = 0; i < size; i++)
+    x[i] = (double)(rand() % 10);
+}
+
+int main(int argc, char *argv[]){
+  int rank, size, provided;
+  int M = argc > 1 ? atoi(argv[1]) : 8; // Número total de linhas da matriz
+  int N = argc > 2 ? atoi(argv[2]) : 4; // Número de colunas da matriz = tamanho do vetor x
+
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (provided < MPI_THREAD_FUNNELED || M <= 0 || N <= 0 || N % size != 0){
+    if (rank == 0)
+      fprintf(stderr, "É preciso MPI_THREAD_FUNNELED (obtido: %d) e N (%d) divisível pelo número de processos (%d)\n",
+              provided, N, size);
+    MPI_Finalize();
+    return 1;
+  }
+
+  // As contagens e deslocamentos das chamadas MPI são int; o maior deslocamento + contagem é M * N
+  if ((size_t)M * N > INT_MAX){
+    if (rank == 0)
+      fprintf(stderr, "Matriz grande demais para as contagens int do MPI\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  int local_cols = N / size;
+  int threads = omp_get_max_threads();
+
+  double *A = NULL;
+  double *x = NULL;
+  double *y = NULL;
+  double *local_A = (double *)malloc((size_t)M * local_cols * sizeof(double));
+  double *local_x = (double *)malloc(local_cols * sizeof(double));
+  double *local_y = (double *)malloc(M * sizeof(double));
+
+  // Primeiro toque do bloco local pelas threads que vão calculá-lo
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < M; i++){
+    for (int j = 0; j < local_cols; j++)
+      local_A[(size_t)i * local_cols + j] = 0.0;
+  }
+
+  if (rank == 0){
+    A = (double *)malloc((size_t)M * N * sizeof(double));
+    x = (double *)malloc(N * sizeof(double));
+    y = (double *)malloc(M * sizeof(double));
+    srand(time(NULL));
+    fill_matrix(A, M, N);
+    fill_vector(x, N);
+  }
+
+  // Mesmo tipo derivado de codigo.c para os blocos de colunas
+  MPI_Datatype col_type, resized_col_type;
+  MPI_Type_vector(M, local_cols, N, MPI_DOUBLE, &col_type);
+  MPI_Type_commit(&col_type);
+  MPI_Type_create_resized(col_type, 0, local_cols * sizeof(double), &resized_col_type);
+  MPI_Type_commit(&resized_col_type);
+
+  // Medição de tempo começa aqui
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start_time = MPI_Wtime();
+
+  MPI_Scatter(A, 1, resized_col_type,
+              local_A, M * local_cols, MPI_DOUBLE,
+              0, MPI_COMM_WORLD);
+
+  MPI_Scatter(x, local_cols, MPI_DOUBLE,
+              local_x, local_cols, MPI_DOUBLE,
+              0, MPI_COMM_WORLD);
+
+  double compute_start = MPI_Wtime();
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < M; i++){
+    const double *row = local_A + (size_t)i * local_cols;
+    double sum = 0.0;
+    #pragma omp simd reduction(+ : sum)
+    for (int j = 0; j < local_cols; j++){
+      sum += row[j] * local_x[j];
+    }
+    local_y[i] = sum;
+  }
+  double compute_time = MPI_Wtime() - compute_start;
+
+  MPI_Reduce(local_y, y, M, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+  double end_time = MPI_Wtime();
+  double elapsed = end_time - start_time;
+
+  double max_compute;
+  MPI_Reduce(&compute_time, &max_compute, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+  int errors = 0;
+  if (rank == 0){
+    // Conferência com o produto sequencial (inteiros pequenos: soma exata em qualquer ordem)
+    for (int i = 0; i < M; i++){
+      double sum = 0.0;
+      for (int j = 0; j < N; j++)
+        sum += A[(size_t)i * N + j] * x[j];
+      if (sum != y[i])
+        errors++;
+    }
+
+    printf("Tempo total de execução com %d processos x %d threads (dist. por colunas) e Matriz %dX%d: %f segundos (cálculo %f, comunicação %f)\n",
+           size, threads, M, N, elapsed, max_compute, elapsed - max_compute);
+    printf("Linhas divergentes: %d\n", errors);
+    printf("csv,colunas,%s,%d,%d,%d,%d,%f,%f\n", threads > 1 ? "hibrido" : "mpi",
+           size, threads, M, N, elapsed, max_compute);
+  }
+
+  free(local_A);
+  free(local_x);
+  free(local_y);
+  if (rank == 0){
+    free(A);
+    free(x);
+    free(y);
+  }
+
+  MPI_Type_free(&col_type);
+  MPI_Type_free(&resized_col_type);
+  MPI_Finalize();
+  return errors != 0;
+}
@@ -0,0 +1,201 @@
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Distribuição por colunas sem o gargalo do processo 0.
+// Em codigo.c o processo 0 guarda A inteira e empacota as colunas de todos com o tipo derivado,
+// em série. Aqui cada processo gera (ou lê com MPI-IO) só o seu bloco de colunas, então a
+// memória e o tempo do processo 0 não crescem com P. O resultado volta já distribuído:
+// MPI_Reduce_scatter_block entrega a cada processo o seu pedaço de y (ou MPI_Reduce_scatter
+// quando M não é divisível por P).
+// Uso: mpirun -np <p> ./codigo_mpiio [M] [N]                 (cada processo gera o seu bloco)
+//      mpirun -np <p> ./codigo_mpiio M N <arquivo>           (lê A, M x N doubles em ordem de linhas)
+//      mpirun -np <p> ./codigo_mpiio M N <arquivo> -w        (gera e grava A no arquivo em paralelo)
+// y só é conferido quando A é a matriz de matrix_value: gerada aqui, ou lida de um arquivo gravado
+// com -w. Para um arquivo qualquer a conferência é pulada.
+
+// Elementos determinísticos, para que cada processo gere o seu pedaço sem comunicação
+double matrix_value(int i, int j, int N){
+  return (double)(((long)i * N + j) % 10);
+}
+
+double vector_value(int j){
+  return (double)(j % 10);
+}
+
+// Tamanho e início do bloco idx quando n elementos são divididos em p blocos
+int block_size(int n, int p, int idx){
+  return n / p + (idx < n % p ? 1 : 0);
+}
+
+int block_start(int n, int p, int idx){
+  return idx * (n / p) + (idx < n % p ? idx : n % p);
+}
+
+int main(int argc, char *argv[]){
+  int rank, size;
+  int M = argc > 1 ? atoi(argv[1]) : 8; // Número total de linhas da matriz
+  int N = argc > 2 ? atoi(argv[2]) : 4; // Número de colunas da matriz = tamanho do vetor x
+  const char *path = argc > 3 ? argv[3] : NULL;
+  int write_file = argc > 4 && strcmp(argv[4], "-w") == 0;
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (M <= 0 || N <= 0){
+    if (rank == 0)
+      fprintf(stderr, "M (%d) e N (%d) devem ser positivos\n", M, N);
+    MPI_Finalize();
+    return 1;
+  }
+
+  int local_cols = block_size(N, size, rank);
+  int first_col = block_start(N, size, rank);
+  int local_rows = block_size(M, size, rank); // Pedaço de y que fica com este processo
+  int first_row = block_start(M, size, rank);
+
+  double *local_A = malloc(((size_t)M * local_cols + 1) * sizeof(double));
+  double *local_x = malloc((local_cols + 1) * sizeof(double));
+  double *partial_y = malloc(M * sizeof(double));
+  double *local_y = malloc((local_rows + 1) * sizeof(double));
+  int *y_counts = malloc(size * sizeof(int));
+  for (int p = 0; p < size; p++)
+    y_counts[p] = block_size(M, size, p);
+
+  // Visão do arquivo: a submatriz M x local_cols que começa na coluna first_col
+  MPI_Datatype file_view;
+  int sizes[2] = {M, N};
+  int subsizes[2] = {M, local_cols};
+  int starts[2] = {0, first_col};
+  MPI_Type_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, MPI_DOUBLE, &file_view);
+  MPI_Type_commit(&file_view);
+
+  // Medição de tempo começa aqui (inclui a obtenção dos dados de A)
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start_time = MPI_Wtime();
+
+  int from_file = path != NULL && !write_file;
+  if (from_file){
+    MPI_File fh;
+    if (MPI_File_open(MPI_COMM_WORLD, path, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS){
+      if (rank == 0)
+        fprintf(stderr, "Erro ao abrir %s\n", path);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_Offset file_size;
+    MPI_File_get_size(fh, &file_size);
+    if (file_size < (MPI_Offset)M * N * (MPI_Offset)sizeof(double)){
+      if (rank == 0)
+        fprintf(stderr, "%s tem %lld bytes, menos que os %dX%d doubles de A\n", path, (long long)file_size, M, N);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_File_set_view(fh, 0, MPI_DOUBLE, file_view, "native", MPI_INFO_NULL);
+    if (MPI_File_read_all(fh, local_A, M * local_cols, MPI_DOUBLE, MPI_STATUS_IGNORE) != MPI_SUCCESS){ // Leitura coletiva
+      fprintf(stderr, "Processo %d: erro ao ler %s\n", rank, path);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_File_close(&fh);
+  } else {
+    for (int i = 0; i < M; i++){
+      for (int j = 0; j < local_cols; j++)
+        local_A[(size_t)i * local_cols + j] = matrix_value(i, first_col + j, N);
+    }
+  }
+  for (int j = 0; j < local_cols; j++)
+    local_x[j] = vector_value(first_col + j);
+
+  double load_time = MPI_Wtime() - start_time;
+
+  // Cálculo: contribuição parcial deste bloco de colunas para y inteiro
+  for (int i = 0; i < M; i++){
+    double sum = 0.0;
+    for (int j = 0; j < local_cols; j++){
+      sum += local_A[(size_t)i * local_cols + j] * local_x[j];
+    }
+    partial_y[i] = sum;
+  }
+
+  // Soma das contribuições, com y já saindo distribuído
+  if (M % size == 0)
+    MPI_Reduce_scatter_block(partial_y, local_y, M / size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  else
+    MPI_Reduce_scatter(partial_y, local_y, y_counts, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+  double end_time = MPI_Wtime();
+  double elapsed = end_time - start_time;
+
+  if (write_file){ // Grava o bloco gerado: cada processo escreve as suas colunas
+    MPI_File fh;
+    if (MPI_File_open(MPI_COMM_WORLD, path, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS){
+      if (rank == 0)
+        fprintf(stderr, "Erro ao criar %s\n", path);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_File_set_size(fh, 0); // MPI_MODE_CREATE não trunca: sem isso sobra o fim de um arquivo maior
+    MPI_File_set_view(fh, 0, MPI_DOUBLE, file_view, "native", MPI_INFO_NULL);
+    int write_ok = MPI_File_write_all(fh, local_A, M * local_cols, MPI_DOUBLE, MPI_STATUS_IGNORE) == MPI_SUCCESS;
+    write_ok = MPI_File_close(&fh) == MPI_SUCCESS && write_ok;
+    int all_ok;
+    MPI_Allreduce(&write_ok, &all_ok, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+    if (!all_ok){
+      if (rank == 0)
+        fprintf(stderr, "Erro ao gravar %s\n", path);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+  }
+
+  // A referência de matrix_value só vale se A é a matriz gerada (um arquivo de -w, por exemplo)
+  int generated = 1;
+  if (from_file){
+    int local_generated = 1;
+    for (int i = 0; i < M && local_generated; i++){
+      for (int j = 0; j < local_cols; j++){
+        if (local_A[(size_t)i * local_cols + j] != matrix_value(i, first_col + j, N)){
+          local_generated = 0;
+          break;
+        }
+      }
+    }
+    MPI_Allreduce(&local_generated, &generated, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+  }
+
+  // Conferência local do pedaço de y de cada processo
+  int local_errors = 0;
+  for (int i = 0; i < local_rows && generated; i++){
+    double sum = 0.0;
+    for (int j = 0; j < N; j++)
+      sum += matrix_value(first_row + i, j, N) * vector_value(j);
+    if (sum != local_y[i])
+      local_errors++;
+  }
+  int errors;
+  MPI_Allreduce(&local_errors, &errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  double max_load;
+  MPI_Reduce(&load_time, &max_load, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+  if (rank == 0){
+    printf("Tempo total de execução com %d processos (dist. por colunas, %s) e Matriz %dX%d: %f segundos\n",
+           size, from_file ? "MPI-IO" : "geração local", M, N, elapsed);
+    printf("Obtenção de A: %f segundos; memória de A no processo 0: %.2f MB\n",
+           max_load, (double)M * local_cols * sizeof(double) / 1e6);
+    if (generated)
+      printf("Linhas divergentes: %d\n", errors);
+    else
+      printf("Conferência pulada: %s não contém a matriz gerada por este programa\n", path);
+    if (write_file)
+      printf("Matriz gravada em %s\n", path);
+  }
+
+  free(local_A);
+  free(local_x);
+  free(partial_y);
+  free(local_y);
+  free(y_counts);
+
+  MPI_Type_free(&file_view);
+  MPI_Finalize();
+  return errors != 0;
+}
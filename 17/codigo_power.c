@@ -0,0 +1,157 @@
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+// Método da potência com a matriz distribuída por colunas e mantida nos processos.
+// Cada processo guarda um bloco de colunas de A e o pedaço correspondente de x. A cada iteração
+// calcula sua contribuição parcial para y inteiro, e o MPI_Reduce_scatter soma as contribuições
+// e já devolve a cada processo o seu pedaço de y, que é o próximo pedaço de x.
+// Uso: mpirun -np <p> ./codigo_power [N] [máximo de iterações] [tolerância]
+
+void fill_matrix(double *A, int rows, int cols){
+  for (int i = 0; i < rows * cols; i++)
+    A[i] = (double)(rand() % 10);
+}
+
+// Tamanho e início do bloco idx quando n elementos são divididos em p blocos
+int block_size(int n, int p, int idx){
+  return n / p + (idx < n % p ? 1 : 0);
+}
+
+int block_start(int n, int p, int idx){
+  return idx * (n / p) + (idx < n % p ? idx : n % p);
+}
+
+int main(int argc, char *argv[]){
+  int rank, size;
+  int N = argc > 1 ? atoi(argv[1]) : 8;           // Matriz N x N
+  int max_iter = argc > 2 ? atoi(argv[2]) : 1000; // Máximo de iterações
+  double tol = argc > 3 ? atof(argv[3]) : 1e-10;  // Critério de parada relativo no autovalor
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (N <= 0 || max_iter <= 0 || tol <= 0.0){
+    if (rank == 0)
+      fprintf(stderr, "N (%d), iterações (%d) e tolerância (%g) devem ser positivos\n", N, max_iter, tol);
+    MPI_Finalize();
+    return 1;
+  }
+
+  int *col_counts = malloc(size * sizeof(int));
+  int *col_displs = malloc(size * sizeof(int));
+  for (int p = 0; p < size; p++){
+    col_counts[p] = block_size(N, size, p);
+    col_displs[p] = block_start(N, size, p);
+  }
+  int local_cols = col_counts[rank];
+
+  double *A = NULL;
+  double *local_A = malloc(((size_t)N * local_cols + 1) * sizeof(double));
+  double *local_x = malloc((local_cols + 1) * sizeof(double));
+  double *partial_y = malloc(N * sizeof(double)); // Contribuição parcial para y inteiro
+  double *iter_times = malloc(max_iter * sizeof(double));
+
+  if (rank == 0){
+    A = (double *)malloc((size_t)N * N * sizeof(double));
+    srand(time(NULL));
+    fill_matrix(A, N, N);
+  }
+
+  // Tipos de uma coluna (N elementos) redimensionados para 1 double: os deslocamentos do
+  // Scatterv ficam em colunas e os blocos podem ter larguras diferentes.
+  MPI_Datatype col_type, resized_col_type, local_col_type, resized_local_col_type;
+  MPI_Type_vector(N, 1, N, MPI_DOUBLE, &col_type);
+  MPI_Type_create_resized(col_type, 0, sizeof(double), &resized_col_type);
+  MPI_Type_commit(&resized_col_type);
+  MPI_Type_vector(N, 1, local_cols > 0 ? local_cols : 1, MPI_DOUBLE, &local_col_type);
+  MPI_Type_create_resized(local_col_type, 0, sizeof(double), &resized_local_col_type);
+  MPI_Type_commit(&resized_local_col_type);
+
+  // --- Distribuição (uma única vez) ---
+  double dist_start = MPI_Wtime();
+  MPI_Scatterv(A, col_counts, col_displs, resized_col_type,
+               local_A, local_cols, resized_local_col_type, 0, MPI_COMM_WORLD);
+  double dist_time = MPI_Wtime() - dist_start;
+
+  for (int j = 0; j < local_cols; j++)
+    local_x[j] = 1.0 / sqrt((double)N);
+
+  // --- Iterações: só o vetor é comunicado ---
+  double lambda = 0.0, lambda_old = 0.0;
+  int iter = 0, converged = 0, null_vector = 0;
+  double loop_start = MPI_Wtime();
+
+  while (iter < max_iter && !converged){
+    double t0 = MPI_Wtime();
+
+    for (int i = 0; i < N; i++){
+      double sum = 0.0;
+      for (int j = 0; j < local_cols; j++){
+        sum += local_A[i * local_cols + j] * local_x[j];
+      }
+      partial_y[i] = sum;
+    }
+
+    // Soma as contribuições e entrega a cada processo o seu pedaço de y
+    MPI_Reduce_scatter(partial_y, local_x, col_counts, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+    double local_norm2 = 0.0;
+    for (int j = 0; j < local_cols; j++)
+      local_norm2 += local_x[j] * local_x[j];
+    double norm2;
+    MPI_Allreduce(&local_norm2, &norm2, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    lambda = sqrt(norm2);
+    if (norm2 == 0.0){ // A x = 0: não há como normalizar (norm2 é o mesmo em todos os processos)
+      null_vector = 1;
+      iter_times[iter++] = MPI_Wtime() - t0;
+      break;
+    }
+
+    for (int j = 0; j < local_cols; j++)
+      local_x[j] /= lambda;
+
+    converged = iter > 0 && fabs(lambda - lambda_old) <= tol * fabs(lambda);
+    lambda_old = lambda;
+    iter_times[iter++] = MPI_Wtime() - t0;
+  }
+
+  double loop_time = MPI_Wtime() - loop_start;
+
+  if (rank == 0){
+    double min_t = iter_times[0], max_t = iter_times[0];
+    for (int k = 1; k < iter; k++){
+      if (iter_times[k] < min_t) min_t = iter_times[k];
+      if (iter_times[k] > max_t) max_t = iter_times[k];
+    }
+
+    printf("Método da potência com %d processos e Matriz %dX%d (dist. por colunas)\n", size, N, N);
+    if (null_vector)
+      printf("A x = 0 na iteração %d: x está no núcleo de A e o método da potência não pode continuar\n", iter);
+    else
+      printf("Autovalor dominante: %.12f (%s em %d iterações)\n", lambda,
+             converged ? "convergiu" : "não convergiu", iter);
+    printf("Distribuição de A (uma vez): %f segundos\n", dist_time);
+    printf("Iterações: %f segundos no total, por iteração média %f / mín %f / máx %f segundos\n",
+           loop_time, loop_time / iter, min_t, max_t);
+  }
+
+  free(col_counts);
+  free(col_displs);
+  free(local_A);
+  free(local_x);
+  free(partial_y);
+  free(iter_times);
+  if (rank == 0)
+    free(A);
+
+  MPI_Type_free(&col_type);
+  MPI_Type_free(&resized_col_type);
+  MPI_Type_free(&local_col_type);
+  MPI_Type_free(&resized_local_col_type);
+  MPI_Finalize();
+  return null_vector;
+}